@@ -130,6 +130,17 @@ class NS_Mesh_Link_Panel(Panel):
         default='1'  # Set a default value
     )
 
+    bpy.types.Scene.ns_split_normals = bpy.props.EnumProperty(
+        name="Split Normals",
+        description="How normals of meshes with split normal indices are written",
+        items=[
+            ('0', "Preserve", "Keep the original game normals"),
+            ('1', "Weld", "Weld Blender normals within a small tolerance and rebuild the normal indices"),
+            ('2', "Weld Encoded", "Weld Blender normals that encode to the same 10-bit value")
+        ],
+        default='0'
+    )
+
     def build_file_link(self, scene):
         user_path = scene.ns_panel_path
         link      = scene.ns_link
@@ -151,6 +162,9 @@ class NS_Mesh_Link_Panel(Panel):
         row = layout.row().box().row()
         row.label(text="Inject Settings:", icon='MODIFIER')
         row.prop(scene, "ns_inject_mode", expand=True)
+        row = layout.row().box().row()
+        row.label(text="Split Normals:")
+        row.prop(scene, "ns_split_normals", expand=True)
         return
     
     def draw(self, context):
@@ -203,6 +217,7 @@ def register_mesh_inject_tool():
 # Unregister properties and classes
 def unregister_mesh_inject_tool():
     del bpy.types.Scene.ns_inject_mode
+    del bpy.types.Scene.ns_split_normals
     del bpy.types.Scene.ns_link
     bpy.utils.unregister_class(NS_Mesh_Link_Panel)
     bpy.utils.unregister_class(NSMeshOperator)
@@ -48,21 +48,24 @@ class CMeshLink():
             print(f"[NSLink] Blender mesh '{self.blender_obj_id}' was deleted or destroyed. Failed to update.")
             return False
         
-        if not self.is_mesh_match(blender_obj.data, self.target_mesh):
+        # Vertex ID injection relies on an untouched topology, spatial matching does not
+        search_method = int(context.scene.ns_inject_mode)
+        split_normals = int(context.scene.ns_split_normals)
+        if search_method == 1 and not self.is_mesh_match(blender_obj.data, self.target_mesh):
             print(f"[NSLink] Blender mesh '{self.blender_obj_id}' has mismatching triangles and vertices. Failed to update.")
             return False
         
         # Define Mesh Data
         mesh_name     = self.target_mesh.name
         verts         = getMeshVertices(blender_obj)
-        texcoords     = verts # getTexCoords(self.blender_obj)
+        uv_maps       = getTexCoords(blender_obj)
+        texcoords     = uv_maps[0] if uv_maps else None
         norms         = getVertexNorms(blender_obj)
         num_tris      = len(self.target_mesh.index_list)
-        search_method = int(context.scene.ns_inject_mode)
         print(f"[NSLink] Injecting Blender mesh '{self.blender_obj_id}' ...")
 
         # Perform scene json update
-        return cscnelib.updateFileMesh(path, mesh_name, verts, texcoords, norms, len(verts), num_tris, search_method)
+        return cscnelib.updateFileMesh(path, mesh_name, self.target_mesh.fingerprint, verts, texcoords, norms, len(verts) // 3, num_tris, search_method, split_normals)
     
     def __init__(self):
         self.name              = None
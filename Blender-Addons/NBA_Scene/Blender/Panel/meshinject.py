@@ -106,9 +106,9 @@ class NS_Mesh_Link_Panel(Panel):
     # Non-GUI Attributes
     bpy.types.Scene.ns_inject_mode = bpy.props.EnumProperty(
         name="Inject Mode",
-        description="Choose between using UVs or Vertex ID",
+        description="Choose between spatial matching or Vertex ID",
         items=[
-            ('0', "Use UVs", "Use UVs for injection"),
+            ('0', "Use Position", "Match vertices by position, UVs and normals (allows topology changes)"),
             ('1', "Use Vertex ID", "Use Vertex ID for injection")
         ],
         default='1'  # Set a default value
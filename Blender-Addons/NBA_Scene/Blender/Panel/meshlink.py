@@ -23,13 +23,14 @@ class CMeshLink():
         # Define Mesh Data
         mesh_name     = self.target_mesh.name
         verts         = getMeshVertices(self.blender_obj)
-        texcoords     = verts # getTexCoords(self.blender_obj)
+        uv_maps       = getTexCoords(self.blender_obj)
+        texcoords     = uv_maps[0] if uv_maps else None
         norms         = getVertexNorms(self.blender_obj)
         num_tris      = len(self.target_mesh.index_list)
         search_method = int(context.scene.ns_inject_mode)
 
         # Perform scene json update
-        return cscnelib.updateFileMesh(path, mesh_name, verts, texcoords, norms, len(verts), num_tris, search_method)
+        return cscnelib.updateFileMesh(path, mesh_name, self.target_mesh.fingerprint, verts, texcoords, norms, len(verts) // 3, num_tris, search_method)
     
     def __init__(self):
         self.name         = None
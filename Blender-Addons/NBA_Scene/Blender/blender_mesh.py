@@ -1,5 +1,6 @@
 import bpy
 import bmesh
+import numpy as np
 
 def setMeshSmoothing(bmesh):
     for f in bmesh.polygons:
@@ -57,11 +58,13 @@ def setVertexGroups(obj, vertex_skin):
     # Create a new vertex group and append defined weights
     for i, group in enumerate(vertex_skin.groups):
         vertex_group = obj.vertex_groups.new(name=group)
-        vertex_weights = vertex_skin.weights[i]
+        vertex_ids, vertex_weights = vertex_skin.weights[i]
 
-        for index, weight in enumerate(vertex_weights):
+        # Quantized weights repeat a lot - add every vertex sharing a weight in one call
+        for weight in np.unique(vertex_weights):
             if (weight != 0.0):
-                vertex_group.add([index], weight, 'ADD')
+                indices = vertex_ids[vertex_weights == weight]
+                vertex_group.add(indices.tolist(), float(weight), 'ADD')
     return
 
 def setMaterials(obj, groups, model_path):
@@ -156,35 +156,39 @@ class cscnelib():
         return lib.getFileStatus(file_path.encode('utf-8'))
     
     @staticmethod
-    def updateFileMesh(file_path, id, vertices, texcoords, normals, num_verts, num_tris, search_method):
+    def updateFileMesh(file_path, id, fingerprint, vertices, texcoords, normals, num_verts, num_tris, search_method, split_normals=0):
 
         lib = ctypes.CDLL( GetDLLPath() )
 
         lib.updateMeshData.restype  = ctypes.c_bool
         lib.updateMeshData.argtypes = [ctypes.c_char_p, # file path
                                                ctypes.c_char_p, # mesh id
+                                               ctypes.c_uint64, # mesh fingerprint
                                                ctypes.POINTER(ctypes.c_float), # position input
                                                ctypes.POINTER(ctypes.c_float), # texcoords input
                                                ctypes.POINTER(ctypes.c_float), # normals input
                                                ctypes.c_int, # num verts
                                                ctypes.c_int, # num tris
-                                               ctypes.c_int  # enum search method
+                                               ctypes.c_int, # enum search method
+                                               ctypes.c_int  # enum split normals
                                                ]
         
         # Convert python list to c array
-        c_verts     = (ctypes.c_float * num_verts)(*vertices)
-        c_texcoords = (ctypes.c_float * num_verts)(*texcoords)
-        c_norms     = (ctypes.c_float * num_verts)(*normals)
+        c_verts     = (ctypes.c_float * len(vertices))(*vertices)
+        c_texcoords = (ctypes.c_float * len(texcoords))(*texcoords) if texcoords else None
+        c_norms     = (ctypes.c_float * len(normals))(*normals)
 
         return lib.updateMeshData(
             file_path.encode('utf-8'),
             id.encode('utf-8'),
+            fingerprint,
             c_verts, 
             c_texcoords,
             c_norms,
             num_verts, 
             num_tris,
-            search_method)
+            search_method,
+            split_normals)
     
 class cmodellib():
 
@@ -195,6 +199,27 @@ class cmodellib():
         lib.saveModelToFile.argtypes = [ctypes.c_void_p, ctypes.c_char_p]
         return lib.saveModelToFile(cmodel, path.encode("utf-8"))
 
+    @staticmethod
+    def setExportVertexOrder(optimize):
+        lib.setExportVertexOrder.argtypes = [ctypes.c_bool]
+        return lib.setExportVertexOrder(optimize)
+
+    @staticmethod
+    def setExportLodRatios(ratios):
+        data = (ctypes.c_float * len(ratios))(*ratios)
+        lib.setExportLodRatios.argtypes = [ctypes.POINTER(ctypes.c_float), ctypes.c_int]
+        return lib.setExportLodRatios(data, len(ratios))
+
+    @staticmethod
+    def setExportPositionError(max_error):
+        lib.setExportPositionError.argtypes = [ctypes.c_float]
+        return lib.setExportPositionError(max_error)
+
+    @staticmethod
+    def setExportInterleaved(interleave):
+        lib.setExportInterleaved.argtypes = [ctypes.c_bool]
+        return lib.setExportInterleaved(interleave)
+
     @staticmethod
     def free_model(cmodelfile):
         lib.release_model.argtypes = [ctypes.c_void_p]
@@ -264,6 +289,12 @@ class cmodellib():
         lib.getNumTriangles.argtypes = [ctypes.c_void_p, ctypes.c_int] 
         return lib.getNumTriangles(cskinmodel, mesh_index)
 
+    @staticmethod
+    def getMeshFingerprint(cskinmodel, mesh_index):
+        lib.getMeshFingerprint.restype  = ctypes.c_uint64
+        lib.getMeshFingerprint.argtypes = [ctypes.c_void_p, ctypes.c_int] 
+        return lib.getMeshFingerprint(cskinmodel, mesh_index)
+
     @staticmethod
     def getNumVerts(cskinmodel, mesh_index):
         lib.getNumVerts.restype  = ctypes.c_int
@@ -353,6 +384,52 @@ class cmodellib():
         lib.getAllJointWeights.argtypes = [ctypes.c_void_p, ctypes.c_char_p, ctypes.POINTER(ctypes.c_int)] 
         return lib.getAllJointWeights(cskinmodel, bone_name, size_p)
 
+    @staticmethod
+    def getSkinSize(cskin, num_verts_p, num_influences_p, num_groups_p):
+        lib.getSkinSize.argtypes = [ctypes.c_void_p, ctypes.POINTER(ctypes.c_int), ctypes.POINTER(ctypes.c_int), ctypes.POINTER(ctypes.c_int)] 
+        return lib.getSkinSize(cskin, num_verts_p, num_influences_p, num_groups_p)
+
+    @staticmethod
+    def getSkinInfluences(cskin, offsets, groups, weights):
+        lib.getSkinInfluences.restype  = ctypes.c_bool
+        lib.getSkinInfluences.argtypes = [ctypes.c_void_p, ctypes.POINTER(ctypes.c_uint32), ctypes.POINTER(ctypes.c_uint16), ctypes.POINTER(ctypes.c_float)] 
+        return lib.getSkinInfluences(cskin,
+                                     offsets.ctypes.data_as(ctypes.POINTER(ctypes.c_uint32)),
+                                     groups.ctypes.data_as(ctypes.POINTER(ctypes.c_uint16)),
+                                     weights.ctypes.data_as(ctypes.POINTER(ctypes.c_float)))
+
+    @staticmethod
+    def getNumMorphs(cskinmodel, mesh_index):
+        lib.getNumMorphs.argtypes = [ctypes.c_void_p, ctypes.c_int]
+        return lib.getNumMorphs(cskinmodel, mesh_index)
+
+    @staticmethod
+    def getMorphName(cskinmodel, mesh_index, target):
+        lib.getMorphName.restype  = ctypes.c_char_p
+        lib.getMorphName.argtypes = [ctypes.c_void_p, ctypes.c_int, ctypes.c_int]
+        return lib.getMorphName(cskinmodel, mesh_index, target)
+
+    @staticmethod
+    def getMorphSize(cskinmodel, mesh_index, target):
+        lib.getMorphSize.argtypes = [ctypes.c_void_p, ctypes.c_int, ctypes.c_int]
+        return lib.getMorphSize(cskinmodel, mesh_index, target)
+
+    @staticmethod
+    def getMorphDeltas(cskinmodel, mesh_index, target, indices, deltas):
+        lib.getMorphDeltas.restype  = ctypes.c_bool
+        lib.getMorphDeltas.argtypes = [ctypes.c_void_p, ctypes.c_int, ctypes.c_int, ctypes.POINTER(ctypes.c_uint32), ctypes.POINTER(ctypes.c_float)]
+        return lib.getMorphDeltas(cskinmodel, mesh_index, target,
+                                  indices.ctypes.data_as(ctypes.POINTER(ctypes.c_uint32)),
+                                  deltas.ctypes.data_as(ctypes.POINTER(ctypes.c_float)))
+
+    @staticmethod
+    def evaluateMorphs(cskinmodel, mesh_index, weights, vertices):
+        lib.evaluateMorphs.restype  = ctypes.c_bool
+        lib.evaluateMorphs.argtypes = [ctypes.c_void_p, ctypes.c_int, ctypes.POINTER(ctypes.c_float), ctypes.c_int, ctypes.POINTER(ctypes.c_float)]
+        return lib.evaluateMorphs(cskinmodel, mesh_index,
+                                  weights.ctypes.data_as(ctypes.POINTER(ctypes.c_float)), len(weights),
+                                  vertices.ctypes.data_as(ctypes.POINTER(ctypes.c_float)))
+
     @staticmethod
     def getMaterialFaceGroup(cskinmodel, mesh_index, group_index, face_begin_p, face_end_p):
         lib.getMaterialFaceGroup.argtypes = [ctypes.c_void_p, ctypes.c_int, ctypes.c_int, ctypes.POINTER(ctypes.c_int), ctypes.POINTER(ctypes.c_int)] 
@@ -374,6 +451,16 @@ class cmodellib():
         return lib.setNewModelBone(cskinmodel, bone_name.encode("utf-8"), cmatrices, index, parent_name.encode("utf-8"))
 
 
+# Mirrors 'enLoadStage' / 'StLoadProgress' in loadcontext.h
+LOAD_QUEUED, LOAD_READ_JSON, LOAD_SCAN_FILES, LOAD_MODELS, LOAD_DONE, LOAD_FAILED, LOAD_CANCELLED = range(7)
+
+class LoadProgress(ctypes.Structure):
+    _fields_ = [("stage",         ctypes.c_int),
+                ("models_loaded", ctypes.c_int),
+                ("models_total",  ctypes.c_int),
+                ("meshes_loaded", ctypes.c_int),
+                ("bytes_read",    ctypes.c_uint64)]
+
 class ExternalLibary():
     def getLoadOperator(self):
         # Defines Call for 'void* loadModelFile(const char* filePath, CNBAScene* pScene)'
@@ -386,6 +473,18 @@ class ExternalLibary():
         self.dynamic_lib.release_model_file.argtypes = [ctypes.c_void_p]
         return self.dynamic_lib.release_model_file
 
+    def getAsyncLoadOperators(self):
+        # Defines Calls for 'beginLoadModelFile', 'pollLoad', 'cancelLoad' and 'finishLoad'
+        self.dynamic_lib.beginLoadModelFile.restype  = ctypes.c_void_p
+        self.dynamic_lib.beginLoadModelFile.argtypes = [ctypes.c_char_p, ctypes.c_bool, ctypes.c_bool]
+        self.dynamic_lib.pollLoad.restype            = ctypes.c_int
+        self.dynamic_lib.pollLoad.argtypes           = [ctypes.c_void_p, ctypes.POINTER(LoadProgress)]
+        self.dynamic_lib.cancelLoad.argtypes         = [ctypes.c_void_p]
+        self.dynamic_lib.finishLoad.restype          = ctypes.c_void_p
+        self.dynamic_lib.finishLoad.argtypes         = [ctypes.c_void_p, ctypes.POINTER(ctypes.c_void_p)]
+        return (self.dynamic_lib.beginLoadModelFile, self.dynamic_lib.pollLoad,
+                self.dynamic_lib.cancelLoad, self.dynamic_lib.finishLoad)
+
     def __init__(self):
         # Define global library handle
         global lib
@@ -394,5 +493,7 @@ class ExternalLibary():
         self.dynamic_lib          = lib
         self.load_scene           = self.getLoadOperator()
         self.release_scene_file   = self.getDeleteOperator()
+        (self.begin_load, self.poll_load,
+         self.cancel_load, self.finish_load) = self.getAsyncLoadOperators()
 
 
@@ -10,6 +10,9 @@ def getMeshName(mesh):
 def getNumVerts(mesh):
     return cmodellib.getNumVerts(mesh.data, mesh.id)
 
+def getFingerprint(mesh):
+    return cmodellib.getMeshFingerprint(mesh.data, mesh.id)
+
 def getNumTris(mesh):
     return cmodellib.getNumTriangles(mesh.data, mesh.id)
 
@@ -93,6 +96,7 @@ class vCSkinMesh():
         # Populate mesh data from c model library
         self.name            = getMeshName(self)
         self.mesh_name       = getMeshName(self)
+        self.fingerprint     = getFingerprint(self)
         self.vertices        = getMeshVerts(self)
         self.vertex_normals  = getMeshNormals(self)
         self.index_list      = getIndexList(self)
@@ -108,6 +112,7 @@ class vCSkinMesh():
         self.motion_flag     = None
         self.name            = None
         self.mesh_name       = None
+        self.fingerprint     = 0
         self.id              = index
         self.vertices        = None
         self.vertex_normals  = None
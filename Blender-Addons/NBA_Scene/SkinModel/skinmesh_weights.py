@@ -20,16 +20,24 @@ def getAllSkinGroups(cskin):
 def getAllSkinWeights(cskin, groups):
     if (not groups): return None
 
-    size = ctypes.c_int()
-    weights = [float] * len(groups)
-
-    for i, group in enumerate(groups):
-        data = cmodellib.getAllJointWeights(cskin, group.encode('utf-8'), ctypes.byref(size) )
-        weights[i] = np.ctypeslib.as_array(data, shape=(size.value,)).tolist()
-
-        # Free allocated memory
-        cmodellib.free_float_array(data)
-    return weights
+    num_verts      = ctypes.c_int()
+    num_influences = ctypes.c_int()
+    num_groups     = ctypes.c_int()
+    cmodellib.getSkinSize(cskin, ctypes.byref(num_verts), ctypes.byref(num_influences), ctypes.byref(num_groups))
+
+    # One call fills the whole skin (CSR: vertex offsets, group per influence, weight per influence)
+    offsets = np.zeros(num_verts.value + 1, dtype=np.uint32)
+    joints  = np.zeros(num_influences.value, dtype=np.uint16)
+    values  = np.zeros(num_influences.value, dtype=np.float32)
+    if not cmodellib.getSkinInfluences(cskin, offsets, joints, values):
+        return None
+
+    # Regroup influences per vertex group -> (vertex indices, weights)
+    vertices = np.repeat(np.arange(num_verts.value, dtype=np.int32), np.diff(offsets).astype(np.int64))
+    order    = np.argsort(joints, kind='stable')
+    splits   = np.cumsum(np.bincount(joints, minlength=len(groups)))[:-1]
+
+    return [(vtx, wgt) for vtx, wgt in zip(np.split(vertices[order], splits), np.split(values[order], splits))]
 
 class vCMeshWeights():
     def __debugLog(self):
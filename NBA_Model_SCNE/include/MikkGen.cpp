@@ -2,8 +2,17 @@
 #include "meshstructs.h"
 
 MikkTCalc::MikkTCalc(Mesh* mesh)
-    : m_mesh(mesh)
+    : MikkTCalc(mesh, mesh->triangles.empty() ? nullptr : mesh->triangles.front().data(), static_cast<int>(mesh->triangles.size()))
 {
+    m_isSubset = false;
+}
+
+MikkTCalc::MikkTCalc(Mesh* mesh, const uint32_t* indices, const int numFaces)
+    : m_mesh(mesh),
+    m_isSubset(true)
+{
+    m_data.indices  = indices;
+    m_data.numFaces = numFaces;
     this->setCallbacks();
 }
 
@@ -19,23 +28,45 @@ void MikkTCalc::setCallbacks()
 
     context.m_pInterface = &iface;
 }
-static void clear_mesh_tangents(Mesh* mesh)
+
+bool MikkTCalc::prepare(Mesh* mesh)
 {
-    int numVerts = mesh->vertices.size() / 3;
+    int stride   = (mesh->vertexComponents > 0) ? mesh->vertexComponents : 3;
+    int numVerts = mesh->vertices.size() / stride;
 
     /* Clear old tangent space data from target mesh  */
-    mesh->tangents. resize (numVerts * 4 );
-    mesh->binormals.resize (numVerts);
+    mesh->tangents. assign (numVerts * 4, 0.0f);
+    mesh->binormals.assign (numVerts, 0.0f);
+
+    if (mesh->uvs.empty() || mesh->uvs.front().map.size() < size_t(numVerts) * 2) {
+        printf("\nMesh is missing uv's, cannot generate mikktspace.");
+        return false;
+    }
+
+    if (mesh->normals.size() < size_t(numVerts) * 3) {
+        printf("\nMesh is missing normals, cannot generate mikktspace.");
+        return false;
+    }
+
+    return true;
 }
 
 void MikkTCalc::generate() 
 {
-    /* Clear old tangent space data from target mesh  */
-    clear_mesh_tangents(this->m_mesh);
+    /* Subsets write into outputs that were sized once for the whole mesh */
+    if (!m_isSubset && !MikkTCalc::prepare(m_mesh))
+        return;
+
+    m_data.positions = m_mesh->vertices.data();
+    m_data.posStride = (m_mesh->vertexComponents > 0) ? m_mesh->vertexComponents : 3;
+    m_data.normals   = m_mesh->normals.data();
+    m_data.texcoords = m_mesh->uvs.front().map.data();
+    m_data.tangents  = m_mesh->tangents.data();
+    m_data.signs     = m_mesh->binormals.data();
 
     /* Interface with Mikk struct and generate mesh tangents */
     try {
-        context.m_pUserData = m_mesh;
+        context.m_pUserData = &m_data;
         genTangSpaceDefault(&this->context); }
     catch (...){
         printf("\nFailed to generate tangent space.");
@@ -44,13 +75,12 @@ void MikkTCalc::generate()
 
 int MikkTCalc::get_num_faces(const SMikkTSpaceContext* context) 
 {
-    Mesh* working_mesh = static_cast<Mesh*> (context->m_pUserData);
-    return working_mesh->triangles.size();
+    auto data = static_cast<const StMikkData*> (context->m_pUserData);
+    return data->numFaces;
 }
 
 int MikkTCalc::get_num_vertices_of_face(const SMikkTSpaceContext* context, const int iFace) 
 {
-    //Mesh* working_mesh = static_cast<Mesh*> (context->m_pUserData);
     return 3;
 }
 
@@ -58,69 +88,54 @@ void MikkTCalc::get_position(const SMikkTSpaceContext* context,
     float* outpos,
     const int iFace, const int iVert) 
 {
-    Mesh* mesh = static_cast<Mesh*> (context->m_pUserData);
-
-    auto& index = mesh->triangles[iFace][iVert];
-    auto vertex = mesh->vertex(index);
+    auto data = static_cast<const StMikkData*> (context->m_pUserData);
+    const float* vertex = &data->positions[data->indices[iFace * 3 + iVert] * data->posStride];
 
-    outpos[0] = vertex.x;
-    outpos[1] = vertex.y;
-    outpos[2] = vertex.z;
+    outpos[0] = vertex[0];
+    outpos[1] = vertex[1];
+    outpos[2] = vertex[2];
 }
 
 void MikkTCalc::get_normal(const SMikkTSpaceContext* context,
     float* outnormal,
     const int iFace, const int iVert)
 {
-    Mesh* mesh = static_cast<Mesh*> (context->m_pUserData);
-
-    auto& index = mesh->triangles[iFace][iVert];
-    auto normal = mesh->normal(index);
+    auto data = static_cast<const StMikkData*> (context->m_pUserData);
+    const float* normal = &data->normals[data->indices[iFace * 3 + iVert] * 3];
 
-    outnormal[0] = normal.x;
-    outnormal[1] = normal.y;
-    outnormal[2] = normal.z;
+    outnormal[0] = normal[0];
+    outnormal[1] = normal[1];
+    outnormal[2] = normal[2];
 }
 
 void MikkTCalc::get_tex_coords(const SMikkTSpaceContext* context,
     float* outuv,
     const int iFace, const int iVert) 
 {
-    Mesh* mesh = static_cast<Mesh*> (context->m_pUserData);
-
-    if (mesh->uvs.empty()){
-        throw std::runtime_error("Mesh is missing uv's, cannot generate mikktspace.");
-    }
+    auto data = static_cast<const StMikkData*> (context->m_pUserData);
+    const float* texcoord = &data->texcoords[data->indices[iFace * 3 + iVert] * 2];
 
-    auto& uv_map = mesh->uvs.front();
-    auto& index = mesh->triangles[iFace][iVert];
-    Vec2 texcoord = uv_map.texcoord(index);
-
-    outuv[0] = texcoord.x;
-    outuv[1] = texcoord.y;
+    outuv[0] = texcoord[0];
+    outuv[1] = texcoord[1];
 }
 
 void MikkTCalc::set_tspace_basic(const SMikkTSpaceContext* context,
     const float* tangentu,
     const float fSign, const int iFace, const int iVert) 
 {
-    Mesh* mesh = static_cast<Mesh*> (context->m_pUserData);
+    auto data = static_cast<const StMikkData*> (context->m_pUserData);
 
-    auto& index = mesh->triangles[iFace][iVert];
-    int offset = (index * 4);
+    uint32_t index = data->indices[iFace * 3 + iVert];
+    float* tangent = &data->tangents[index * 4];
 
-    mesh->tangents.at(offset)   = tangentu[0];
-    mesh->tangents.at(offset+1) = tangentu[1];
-    mesh->tangents.at(offset+2) = tangentu[2];
-    mesh->binormals.at(index)   = fSign;
+    tangent[0] = tangentu[0];
+    tangent[1] = tangentu[1];
+    tangent[2] = tangentu[2];
+    data->signs[index] = fSign;
 }
 
 int MikkTCalc::get_vertex_index(const SMikkTSpaceContext* context, int iFace, int iVert)
 {
-    Mesh* mesh = static_cast<Mesh*> (context->m_pUserData);
-
-    auto& index = mesh->triangles[iFace][iVert];
-    return index;
+    auto data = static_cast<const StMikkData*> (context->m_pUserData);
+    return data->indices[iFace * 3 + iVert];
 }
-
-
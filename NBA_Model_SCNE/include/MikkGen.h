@@ -1,20 +1,39 @@
 #include "mikktspace.h"
+#include <cstdint>
 #pragma once
 
 #define CALC_TANGENTS_DEBUG 1
 
 struct Mesh;
 
+// Flat views of the mesh streams - callbacks index these directly instead of building Vec3s
+struct StMikkData
+{
+    const float*    positions = nullptr;
+    int             posStride = 3;
+    const float*    normals   = nullptr;
+    const float*    texcoords = nullptr;
+    const uint32_t* indices   = nullptr; // 3 per face
+    int             numFaces  = 0;
+    float*          tangents  = nullptr; // 4 per vertex
+    float*          signs     = nullptr; // 1 per vertex
+};
+
 class MikkTCalc {
 
 public:
     MikkTCalc(Mesh* mesh);
+    MikkTCalc(Mesh* mesh, const uint32_t* indices, const int numFaces); // face subset - outputs sized by prepare()
+
+    static bool prepare(Mesh* mesh); // sizes tangent outputs, false if the mesh can't be processed
     void generate();
  
 private:
     void setCallbacks();
 
     Mesh* m_mesh;
+    bool m_isSubset;
+    StMikkData m_data;
     SMikkTSpaceInterface iface{};
     SMikkTSpaceContext context{};
 
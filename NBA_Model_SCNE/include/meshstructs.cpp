@@ -1,6 +1,11 @@
 ﻿#include "meshstructs.h"
 #include <databuffer.h>
 #include <MikkGen.h>
+#include <threadpool.h>
+#include <numeric>
+#include <array>
+#include <algorithm>
+#include <cstring>
 #include <armature/armature.h>	
 
 void Mesh::generateAABBs()
@@ -103,6 +108,13 @@ Vec3 Mesh::normal(const int index) const
 	return Vec3{ normals[offset],  normals[offset + 1],  normals[offset + 2] };
 }
 
+uint64_t MeshFingerprint::key() const
+{
+	uint64_t hash = boundsHash ^ (sampleHash * 0x9E3779B97F4A7C15ULL);
+	hash ^= (uint64_t(numVerts) << 32) | numTris;
+	return hash * 0xBF58476D1CE4E5B9ULL;
+}
+
 void Mesh::alignPosition(const bool use_blender_scale, const int num_components)
 {
 	auto size = vertices.size();
@@ -159,6 +171,66 @@ void Mesh::alignNormals(const bool use_blender_scale, const int num_components)
 	}
 }
 
+const float* Mesh::getBlenderPositions()
+{
+	int stride = (vertexComponents > 0) ? vertexComponents : 3;
+	size_t numVerts = vertices.size() / stride;
+	if (numVerts == 0)
+		return nullptr;
+
+	// Fused into the position kernel - nothing left to convert
+	if (stride == 3 && isBlenderAligned)
+		return vertices.data();
+
+	if (blenderPositions.size() != numVerts * 3)
+	{
+		// 4-component (ball) meshes are already placed by their scale/offset transform - only W is dropped
+		bool swapAxes = (stride == 3);
+		blenderPositions.resize(numVerts * 3);
+
+		for (size_t i = 0; i < numVerts; i++)
+		{
+			const float* p = &vertices[i * stride];
+			float* v = &blenderPositions[i * 3];
+			v[0] = p[0];
+			v[1] = (swapAxes) ? -p[2] : p[1];
+			v[2] = (swapAxes) ? p[1] : p[2];
+		}
+	}
+
+	return blenderPositions.data();
+}
+
+const float* Mesh::getBlenderNormals()
+{
+	if (normals.empty())
+		return nullptr;
+
+	// Normals of 4-component meshes are handed over unchanged
+	if (vertexComponents == 4)
+		return normals.data();
+
+	if (blenderNormals.size() != normals.size())
+	{
+		blenderNormals.resize(normals.size());
+
+		for (size_t i = 0; i + 2 < normals.size(); i += 3)
+		{
+			blenderNormals[i] = normals[i];
+			blenderNormals[i + 1] = -normals[i + 2];
+			blenderNormals[i + 2] = normals[i + 1];
+		}
+	}
+
+	return blenderNormals.data();
+}
+
+void Mesh::clearBlenderViews()
+{
+	std::vector<float>().swap(blenderPositions);
+	std::vector<float>().swap(blenderNormals);
+}
+
 Vec3 Mesh::get_center() const
 {
 	auto& aabb = this->bounds;
@@ -377,29 +449,178 @@ void MeshCalc::calculateTangentsBinormals(Mesh& mesh, const bool use_tangents)
 	mikkcalculator.generate();
 }
 
-inline bool hasString(const std::vector<std::string>& vec, const std::string& target)
+// Position, normal and first UV as compared by mikktspace's vertex weld - signed zeros fold to +0 like float ==
+typedef std::array<uint32_t, 8> MikkWeldKey;
+
+static MikkWeldKey getMikkWeldKey(const Mesh& mesh, const uint32_t vtx)
 {
-	return std::find(vec.begin(), vec.end(), target) != vec.end();
+	const float* p = &mesh.vertices[size_t(vtx) * mesh.vertexComponents];
+	const float* n = &mesh.normals[size_t(vtx) * 3];
+	const float* uv = &mesh.uvs.front().map[size_t(vtx) * 2];
+	const float values[8] = { p[0], p[1], p[2], n[0], n[1], n[2], uv[0], uv[1] };
+
+	MikkWeldKey key;
+	for (int i = 0; i < 8; i++) {
+		float value = (values[i] == 0.0f) ? 0.0f : values[i];
+		memcpy(&key[i], &value, sizeof(float));
+	}
+	return key;
 }
 
-void Skin::updateIndices(const NSSkeleton* skeleton)
+// Groups faces by connected component and packs whole components into chunks. Vertices mikktspace would weld
+// (equal position, normal and UV) join one component as well, so every chunk sees the same shared vertices as the
+// whole mesh. Components never share a vertex, so chunks can write their tangents concurrently.
+static void splitFaceChunks(const Mesh& mesh, std::vector<std::vector<uint32_t>>& chunks)
 {
-	// Update blend indices
-	int numIndices;
+	size_t numVerts = mesh.vertices.size() / mesh.vertexComponents;
+	size_t numTris = mesh.triangles.size();
+
+	std::vector<uint32_t> parent(numVerts);
+	std::iota(parent.begin(), parent.end(), 0);
+
+	auto findRoot = [&parent](uint32_t v) {
+		while (parent[v] != v)
+			v = parent[v] = parent[parent[v]];
+		return v;
+	};
 
-	for (auto& vertex : this->blendverts)
+	for (auto& tri : mesh.triangles)
 	{
-		numIndices = vertex.indices.size();
-		vertex.bones.resize(numIndices);
+		parent[findRoot(tri[1])] = findRoot(tri[0]);
+		parent[findRoot(tri[2])] = findRoot(tri[0]);
+	}
 
-		for (int i = 0; i < numIndices; i++)
-		{
-			auto& blendIndex = vertex.indices[i];
+	// Duplicated vertices - sort by weld key and join equal neighbours
+	std::vector<MikkWeldKey> keys(numVerts);
+	std::vector<uint32_t> sorted(numVerts);
+	for (size_t v = 0; v < numVerts; v++)
+		keys[v] = ::getMikkWeldKey(mesh, static_cast<uint32_t>(v));
 
-			if (blendIndex <= skeleton->joints.size())
-				vertex.bones[i] = skeleton->joints[blendIndex]->name;
+	std::iota(sorted.begin(), sorted.end(), 0);
+	std::sort(sorted.begin(), sorted.end(), [&keys](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
+
+	for (size_t i = 1; i < numVerts; i++)
+		if (keys[sorted[i]] == keys[sorted[i - 1]])
+			parent[findRoot(sorted[i])] = findRoot(sorted[i - 1]);
+
+	std::vector<uint32_t> faces(numTris);
+	std::vector<uint32_t> faceRoot(numTris);
+	std::iota(faces.begin(), faces.end(), 0);
+	for (size_t i = 0; i < numTris; i++)
+		faceRoot[i] = findRoot(mesh.triangles[i][0]);
+
+	std::stable_sort(faces.begin(), faces.end(), [&faceRoot](uint32_t a, uint32_t b) { return faceRoot[a] < faceRoot[b]; });
+
+	chunks.clear();
+	for (size_t i = 0; i < numTris;)
+	{
+		if (chunks.empty() || chunks.back().size() >= MIKK_CHUNK_TRIS * 3)
+			chunks.emplace_back();
+
+		// Append the whole component
+		auto& chunk = chunks.back();
+		uint32_t root = faceRoot[faces[i]];
+		for (; i < numTris && faceRoot[faces[i]] == root; i++)
+			chunk.insert(chunk.end(), mesh.triangles[faces[i]].begin(), mesh.triangles[faces[i]].end());
+	}
+}
+
+void MeshCalc::calculateTangentsBinormals(const std::vector<Mesh*>& meshes)
+{
+	struct StTangentJob
+	{
+		Mesh* mesh;
+		std::vector<uint32_t> indices; // empty - whole mesh
+	};
+
+	std::vector<StTangentJob> jobs;
+	if (meshes.empty())
+		return;
+
+	for (auto& mesh : meshes)
+	{
+		mesh->tangents.clear();
+		mesh->binormals.clear();
+
+		if (mesh->uvs.empty()) {
+			MeshCalc::setFlatTangentBinormals(*mesh);
+			continue;
 		}
+
+		if (!MikkTCalc::prepare(mesh) || mesh->triangles.empty())
+			continue;
+
+		if (mesh->triangles.size() <= MIKK_CHUNK_TRIS) {
+			jobs.push_back({ mesh });
+			continue;
+		}
+
+		std::vector<std::vector<uint32_t>> chunks;
+		::splitFaceChunks(*mesh, chunks);
+		for (auto& chunk : chunks)
+			jobs.push_back({ mesh, std::move(chunk) });
+
+		printf("\n[MeshCalc] Split %s into %zu tangent jobs", mesh->name.c_str(), chunks.size());
 	}
+
+	printf("\n[MeshCalc] Calculating Tangents and Binormals for %zu meshes (%zu jobs)", meshes.size(), jobs.size());
+
+	CThreadPool::instance().parallelFor(jobs.size(), 1, 2, [&jobs](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; i++)
+			{
+				auto& job = jobs[i];
+				auto& tris = job.mesh->triangles;
+
+				const uint32_t* indices = (job.indices.empty()) ? tris.front().data() : job.indices.data();
+				int numFaces = static_cast<int>((job.indices.empty()) ? tris.size() : job.indices.size() / 3);
+
+				MikkTCalc mikkcalculator(job.mesh, indices, numFaces);
+				mikkcalculator.generate();
+			}
+		});
+}
+
+inline bool hasString(const std::vector<std::string>& vec, const std::string& target)
+{
+	return std::find(vec.begin(), vec.end(), target) != vec.end();
+}
+
+void Skin::clear()
+{
+	offsets.assign(1, 0);
+	joints.clear();
+	weights.clear();
+}
+
+void Skin::reserve(const size_t numVerts, const size_t numInfluences)
+{
+	offsets.reserve(numVerts + 1);
+	joints.reserve(numInfluences);
+	weights.reserve(numInfluences);
+}
+
+void Skin::pushInfluence(const uint16_t joint, const float weight)
+{
+	joints.push_back(joint);
+	weights.push_back(weight);
+}
+
+void Skin::endVertex()
+{
+	// Close the current vertex range
+	if (offsets.empty())
+		offsets.push_back(0);
+	offsets.push_back(static_cast<uint32_t>(joints.size()));
+}
+
+void Skin::updateIndices(const NSSkeleton* skeleton)
+{
+	// Resolve joint names once per skeleton joint instead of per influence
+	jointNames.resize(skeleton->size());
+
+	for (size_t i = 0; i < skeleton->size(); i++)
+		jointNames[i] = skeleton->getName(int(i));
 }
 
 void Skin::getMinMaxRange(int& min, int& max) const
@@ -407,12 +628,9 @@ void Skin::getMinMaxRange(int& min, int& max) const
 	min = 0;
 	max = 0;
 
-	for (auto& vertex : this->blendverts)
+	for (auto& index : this->joints)
 	{
-		for (auto& index : vertex.indices)
-		{
-			min = (index < min) ? index : min;
-			max = (index > max) ? index : max;
-		}
+		min = (index < min) ? index : min;
+		max = (index > max) ? index : max;
 	}
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <string>
 #include <iostream>
 #include <array>
+#include <memory>
 #include <algorithm>
 #include <json.hpp>
 #include <material/material.h>
@@ -166,14 +167,6 @@ struct BoundingBox
 	float radius;
 };
 
-struct BlendVertex
-{
-	int num_weights = 0;
-	std::vector<int> indices;
-	std::vector<std::string> bones;
-	std::vector<float> weights;
-};
-
 struct BlendShape {
 	std::string name;
 	std::vector<float> vertices;
@@ -183,10 +176,25 @@ struct BlendShape {
 };
 
 struct NSSkeleton;
+class CMorphSet;
 
+// Compact skin - per-vertex influence ranges into packed joint/weight arrays
 struct Skin
 {
-	std::vector<BlendVertex> blendverts;
+	std::vector<uint32_t> offsets;  // numVerts + 1 - influences of vertex i are [offsets[i], offsets[i + 1])
+	std::vector<uint16_t> joints;   // blend (joint) index per influence
+	std::vector<float>    weights;  // weight per influence
+	std::vector<std::string> jointNames; // joint index -> skeleton name, set by updateIndices
+
+	bool empty() const { return offsets.size() <= 1; }
+	size_t getNumVerts() const { return (offsets.empty()) ? 0 : offsets.size() - 1; }
+	uint32_t getNumInfluences(const size_t vtx) const { return offsets[vtx + 1] - offsets[vtx]; }
+
+	void clear();
+	void reserve(const size_t numVerts, const size_t numInfluences);
+	void pushInfluence(const uint16_t joint, const float weight);
+	void endVertex();
+
 	void updateIndices(const NSSkeleton* skeleton);
 	void getMinMaxRange(int& min, int& max) const;
 };
@@ -207,6 +215,25 @@ struct FaceGroup
 	int count;
 };
 
+// Index range (in indices, like FaceGroup) of one exported level of detail
+struct LodRange
+{
+	int begin;
+	int count;
+};
+
+// Load-time identity of a game mesh - stable across reloads, used to find injection targets
+struct MeshFingerprint
+{
+	uint32_t numVerts = 0;
+	uint32_t numTris = 0;
+	uint64_t boundsHash = 0; // quantized AABB
+	uint64_t sampleHash = 0; // quantized positions of evenly spaced vertices
+
+	uint64_t key() const;
+	bool empty() const { return numVerts == 0; }
+};
+
 // Game mesh struct - todo: make this a full class
 struct Mesh
 {
@@ -222,6 +249,13 @@ struct Mesh
 	std::vector<UVMap> uvs;
 	std::vector<FaceGroup> groups;
 
+	// Export LOD chain - lods[0] is 'triangles', lower levels live in lodTriangles and index the same vertices
+	std::vector<Triangle> lodTriangles;
+	std::vector<LodRange> lods;
+
+	MeshFingerprint fingerprint;
+	std::shared_ptr<CMorphSet> morphs; // sparse morph targets of the source model, null when it has none
+
 	int originalFormat = 3;    // Original format before flattening (3 or 4)
 
 	// NBA Specific attributes
@@ -229,11 +263,17 @@ struct Mesh
 	void* normals_ref = NULL;
 	void* texcoord_ref = NULL;
 
+	// Group views (see GeomDef::createGroupMesh) - full mesh vertex of each vertex, used to write updates back in place
+	std::vector<uint32_t> sourceVertices;
+
 	// NEW: Vertex format tracking - CRITICAL FIX for 4-component vertices
 	// Set to 3 for XYZ format, 4 for XYZW format
 	// This prevents vertex data from being scrambled during alignment
 	int vertexComponents = 3;
 
+	// Set when positions were converted to Blender space during decode
+	bool isBlenderAligned = false;
+
 	// ✓ NEW: Split index buffer support
 	bool hasSplitIndices = false;
 	std::vector<uint16_t> normalIndices;
@@ -243,16 +283,18 @@ struct Mesh
 	void* normalIndexRef = nullptr;
 	void* tangentIndexRef = nullptr;
 
-	// NEW: Extracted 3-component data for Blender interface
-	// These are populated by interface functions and persist for Blender to read
-	std::vector<float> extracted_vertices_xyz;
-	std::vector<float> extracted_normals_xyz;
+	// Blender space xyz views handed to the interface - built once on first request, the source streams are never rewritten
+	std::vector<float> blenderPositions;
+	std::vector<float> blenderNormals;
 
 	static void createWAxis(std::vector<float>& data); // used for 2k meshes
 	static void removeWAxis(std::vector<float>& data); // used for 2k meshes
 
 	void alignPosition(const bool align_inverse = false, const int num_components = 3); /* Flips all mesh vertices to (x,-z,y) basis */
 	void alignNormals(const bool align_inverse = false, const int num_components = 3);
+	const float* getBlenderPositions(); /* xyz positions in Blender space - the decoded buffer itself when the decode kernel already converted it */
+	const float* getBlenderNormals(); /* xyz normals in Blender space */
+	void clearBlenderViews(); /* Drops the cached views after the source streams changed */
 	void flipNormals(); /* Flips all mesh triangle faces inside out. */
 	void convertSplitNorms(); /* Re-arrange normals for blender import/interface */
 	void translateUVs(const int& index); /* Translates and aligns UV map to Blender/MAX 3D space*/
@@ -267,6 +309,8 @@ struct Mesh
 // Forward declarations
 class CDataBuffer;
 
+#define MIKK_CHUNK_TRIS 0x10000 // meshes above this are split by connected components into jobs of about this many faces
+
 namespace MeshCalc
 {
 	void buildTangentFrameVec(const Mesh& mesh, std::vector<float>& dst);
@@ -276,4 +320,5 @@ namespace MeshCalc
 	Vec3 decodeOctahedralNormal(const Vec3& encoded);
 	void setFlatTangentBinormals(Mesh& mesh);
 	void calculateTangentsBinormals(Mesh& mesh, const bool use_tangents = true);
+	void calculateTangentsBinormals(const std::vector<Mesh*>& meshes); // parallel across meshes and face chunks
 }
\ No newline at end of file
@@ -1,19 +1,58 @@
 #include <armature/armature.h>
 
 
-std::shared_ptr<NSJoint> NSSkeleton::findJoint(const char* name) const
+void NSSkeleton::clear()
 {
-	for (auto& joint : joints)
-	{
-		if (joint->name == name)
-			return joint;
-	}
+	parents.clear();
+	nameIds.clear();
+	translates.clear();
+	names.clear();
+	m_nameIds.clear();
+	m_jointIndex.clear();
+}
 
-	return nullptr;
+void NSSkeleton::resize(const size_t numJoints)
+{
+	this->clear();
+	parents.resize(numJoints, -1);
+	nameIds.resize(numJoints, this->internName(""));
+	translates.resize(numJoints);
 }
 
-void NSSkeleton::addJoint(const std::shared_ptr<NSJoint>& joint)
+uint32_t NSSkeleton::internName(const std::string& name)
 {
-	joints.push_back(joint);
+	auto it = m_nameIds.find(name);
+	if (it != m_nameIds.end())
+		return it->second;
+
+	uint32_t id = static_cast<uint32_t>(names.size());
+	names.push_back(name);
+	m_nameIds.emplace(name, id);
+	return id;
+}
+
+void NSSkeleton::setName(const int joint, const std::string& name)
+{
+	if (!this->isValid(joint))
+		return;
+
+	nameIds[joint] = this->internName(name);
+	m_jointIndex.emplace(name, joint);
 }
 
+int NSSkeleton::addJoint(const std::string& name, const int parent, const Vec3& translate)
+{
+	int joint = static_cast<int>(parents.size());
+	parents.push_back(this->isValid(parent) ? parent : -1);
+	nameIds.push_back(0);
+	translates.push_back(translate);
+	this->setName(joint, name);
+
+	return joint;
+}
+
+int NSSkeleton::findJoint(const std::string& name) const
+{
+	auto it = m_jointIndex.find(name);
+	return (it != m_jointIndex.end()) ? it->second : -1;
+}
@@ -1,22 +1,30 @@
 #include <meshstructs.h>
+#include <unordered_map>
 #pragma once
 
-struct NSJoint 
+// Flat skeleton - one slot per joint in every array, joints referenced by index
+struct NSSkeleton 
 {
-	int index = -1;
-	std::string name;
-	Matrix3 transform;
-	Vec3 translate;
+	std::vector<int> parents;            // parent joint index, -1 for roots
+	std::vector<uint32_t> nameIds;       // index into 'names'
+	std::vector<Vec3> translates;        // local (parent relative) translation
+	std::vector<std::string> names;      // interned joint names
 
-	std::vector<std::shared_ptr<NSJoint>> children;
-	std::shared_ptr<NSJoint> parent;
-};
+	size_t size() const { return parents.size(); }
+	bool empty() const { return parents.empty(); }
+	bool isValid(const int joint) const { return joint >= 0 && joint < int(parents.size()); }
+	const std::string& getName(const int joint) const { return names[nameIds[joint]]; }
 
-struct NSSkeleton 
-{
-	void addJoint(const std::shared_ptr<NSJoint>& joint);
-	std::shared_ptr<NSJoint> findJoint(const char* name) const;
-	std::vector<std::shared_ptr<NSJoint>> joints;
-};
+	void clear();
+	void resize(const size_t numJoints);
+	int addJoint(const std::string& name, const int parent, const Vec3& translate);
+	void setName(const int joint, const std::string& name);
+	int findJoint(const std::string& name) const;
 
+private:
+	uint32_t internName(const std::string& name);
 
+private:
+	std::unordered_map<std::string, uint32_t> m_nameIds;
+	std::unordered_map<std::string, int> m_jointIndex; // first joint using a name
+};
@@ -31,11 +31,7 @@ void CBoneReader::parse()
 
 	// get size of skeleton
 	size_t size = ::getNumJsonChilds(*m_json);
-	m_skeleton->joints.resize(size);
-
-	// create joints
-	for (auto& joint : m_skeleton->joints)
-		joint = std::make_shared<NSJoint>();
+	m_skeleton->resize(size);
 
 	// Load bone data from JSON iterator
 	int index = 0;
@@ -47,37 +43,34 @@ void CBoneReader::parse()
 		}
 }
 
-inline static void loadParent(JSON::iterator& it, std::shared_ptr<NSJoint>& joint, const std::vector<std::shared_ptr<NSJoint>>& joints)
+inline static void loadParent(JSON::iterator& it, const int index, NSSkeleton& skeleton)
 {
 	int parent_index = it.value();
-	if (parent_index > joints.size())
+	if (!skeleton.isValid(parent_index))
 		return;
 
-	joint->parent = joints[parent_index];
-	joint->parent->children.push_back(joint);
+	skeleton.parents[index] = parent_index;
 }
 
-inline static void loadChild(JSON::iterator& it, std::shared_ptr<NSJoint>& joint, const std::vector<std::shared_ptr<NSJoint>>& joints)
+inline static void loadChild(JSON::iterator& it, const int index, NSSkeleton& skeleton)
 {
 	int child_index = it.value();
-	if (child_index > joints.size())
+	if (!skeleton.isValid(child_index))
 		return;
 
-	joints[child_index]->parent = joint;
+	skeleton.parents[child_index] = index;
 }
 
-inline static void loadTranslate(JSON::iterator& it, std::shared_ptr<NSJoint>& joint)
+inline static void loadTranslate(JSON::iterator& it, const int index, NSSkeleton& skeleton)
 {
 	std::vector<float> translate = it.value();
-	joint->translate = { translate[0], translate[1], translate[2] };
+	skeleton.translates[index] = { translate[0], translate[1], translate[2] };
 }
 
 void CBoneReader::loadTransformDef(const int index, const std::string& key, JSON & obj)
 {
-	// create joint
-	auto& joint = m_skeleton->joints[index];
-	joint->name  = key;
-	joint->index = index;
+	// name joint
+	m_skeleton->setName(index, key);
 
 	// collect bone data
 	for (JSON::iterator it = obj.begin(); it != obj.end(); ++it)
@@ -87,15 +80,15 @@ void CBoneReader::loadTransformDef(const int index, const std::string& key, JSON
 		switch (key)
 		{
 			case enBoneTag::PARENT:
-				::loadParent(it, joint, m_skeleton->joints);
+				::loadParent(it, index, *m_skeleton);
 				break;
 			case enBoneTag::CHILD:
-				::loadChild(it, joint, m_skeleton->joints);
+				::loadChild(it, index, *m_skeleton);
 				break;
 			case enBoneTag::SIBLING:
 				break;
 			case enBoneTag::TRANSLATE:
-				::loadTranslate(it, joint);
+				::loadTranslate(it, index, *m_skeleton);
 				break;
 			default:
 				break;
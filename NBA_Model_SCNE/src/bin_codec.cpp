@@ -1,5 +1,8 @@
 #include <bin_codec.h>
 #include <common.h>
+#include <threadpool.h>
+#include <cstring>
+#include <algorithm>
 
 BinaryCodec::BinaryCodec(const char* encode_fmt, const char* data_type)
     :
@@ -50,7 +53,28 @@ BinaryCodec::decode(
     if (it == m_map.end())
         throw std::invalid_argument("Unknown format key: " + m_encodeFmt);
 
-    return it->second->decode(src, size, target, m_type.c_str(), offset, stride);
+    auto& format = it->second;
+    if (size < DECODE_PARALLEL_ITEMS || stride == 0)
+        return format->decode(src, size, target, m_type.c_str(), offset, stride);
+
+    // Elements are independent - decode fixed-size chunks in parallel and place them in order
+    const size_t channels = format->get_channels();
+    const size_t base = target.size();
+    const std::string type = m_type;
+    target.resize(base + (size * channels));
+
+    CThreadPool::instance().parallelFor(size, DECODE_CHUNK_ITEMS, DECODE_PARALLEL_ITEMS,
+        [&](size_t begin, size_t end)
+        {
+            std::vector<float> chunk;
+            chunk.reserve((end - begin) * channels);
+
+            char* chunkSrc = src;
+            format->decode(chunkSrc, int(end - begin), chunk, type, offset + (begin * stride), stride);
+
+            size_t count = std::min(chunk.size(), (end - begin) * channels);
+            memcpy(target.data() + base + (begin * channels), chunk.data(), count * sizeof(float));
+        });
 }
 
 void
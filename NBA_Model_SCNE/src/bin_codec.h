@@ -1,6 +1,10 @@
 #include <bin_format.h>
 #pragma once
 
+// Streams at or above this many elements are decoded in chunks on the shared thread pool
+#define DECODE_CHUNK_ITEMS    16384
+#define DECODE_PARALLEL_ITEMS 131072
+
 class BinaryCodec
 {
 public:
@@ -1,5 +1,7 @@
 ﻿#include <bin_format.h>
 #include <algorithm>
+#include <cstring>
+#include <cmath>
 #include <memoryreader.h>
 
 using namespace memreader;
@@ -300,278 +302,228 @@ void R21G21B22::decode(FMT_DT_PARAMS)
 }
 
 // ============================================
-// UPDATE FUNCTIONS
+// QUANTIZE HELPERS
 // ============================================
 
-template <int Channels>
-void Format_32Bit<Channels>::updateData(INJ_DT_PARAMS)
+enum class enQuantType { RAW, SNORM, UNORM, SINT, UINT };
+
+static enQuantType getQuantType(const std::string& type)
 {
-	int numItems = size / Channels;
+	// Resolved once per stream from the type of the encoded channels (see CDataBuffer::parse)
+	if (type == "snorm") return enQuantType::SNORM;
+	if (type == "unorm") return enQuantType::UNORM;
+	if (type == "sint") return enQuantType::SINT;
+	if (type == "uint") return enQuantType::UINT;
+	return enQuantType::RAW;
+}
+
+// Scales, clamps and rounds to nearest for an integer channel of 'bits' width
+struct StQuantizer
+{
+	float scale = 1.0f;
+	float lo    = 0.0f;
+	float hi    = 0.0f;
 
-	for (int i = 0; i < numItems; i++)
+	StQuantizer(const enQuantType quant, const int bits)
 	{
-		char* stream = src + (i * stride) + offset;
+		const float maxSigned   = static_cast<float>(::getMaxIntValue(bits, true));
+		const float maxUnsigned = static_cast<float>(::getMaxIntValue(bits, false));
 
-		for (int j = 0; j < Channels; j++)
+		switch (quant)
 		{
-			int index = (i * Channels) + j;
-			WriteFloat(stream, target[index]);
+		case enQuantType::SNORM:
+			scale = maxSigned;
+			lo = -maxSigned;
+			hi = maxSigned;
+			break;
+		case enQuantType::UNORM:
+			scale = maxUnsigned;
+			hi = maxUnsigned;
+			break;
+		case enQuantType::SINT:
+			lo = -maxSigned - 1.0f;
+			hi = maxSigned;
+			break;
+		default:
+			hi = maxUnsigned;
+			break;
 		}
 	}
-}
 
-template <int Channels>
-void Format_16Bit<Channels>::updateData(INJ_DT_PARAMS)
-{
-	int numItems = size / Channels;
-
-	for (int i = 0; i < numItems; i++)
+	// Round half away from zero. Every packed channel is at most 22 bits, so a 32-bit convert is
+	// enough - a 64-bit float convert has no SSE2 form and kept these loops scalar
+	inline int32_t operator()(const float value) const
 	{
-		char* stream = src + (i * stride) + offset;
+		float q = std::min(std::max(value * scale, lo), hi);
+		return static_cast<int32_t>(q + copysignf(0.5f, q));
+	}
+};
 
+// Quantizes 'numItems' elements of 'Channels' values into a strided destination in place
+template <typename T, int Channels>
+static void packChannels(char* dst, const float* src, const int numItems, const uint8_t stride, const StQuantizer& quant)
+{
+	for (int i = 0; i < numItems; i++, src += Channels, dst += stride)
+	{
+		T packed[Channels];
 		for (int j = 0; j < Channels; j++)
-		{
-			int index = (i * Channels) + j;
-			float value = target[index];
+			packed[j] = static_cast<T>(quant(src[j]));
 
-			if (type == "snorm" || type == "sint")
-			{
-				int16_t pack = (type == "snorm") ? (value * ::getMaxIntValue(m_bits, true)) : value;
-				WriteSInt16(stream, pack);
-			}
-			else if (type == "unorm" || type == "uint")
-			{
-				uint16_t pack = (type == "unorm") ? (value * ::getMaxIntValue(m_bits, false)) : value;
-				WriteUInt16(stream, pack);
-			}
-		}
+		memcpy(dst, packed, sizeof(packed));
 	}
 }
 
-template <int Channels>
-void Format_8Bit<Channels>::updateData(INJ_DT_PARAMS)
+// Packs three or four channels of custom bit widths into a single 32/64-bit word per element
+template <typename Word, int Channels>
+static void packBitfield(char* dst, const float* src, const int numItems, const uint8_t stride,
+	const StQuantizer* quant, const int* bits, const int* shifts)
 {
-	int numItems = size / Channels;
+	Word masks[Channels];
+	for (int j = 0; j < Channels; j++)
+		masks[j] = (Word(1) << bits[j]) - 1;
 
-	for (int i = 0; i < numItems; i++)
+	for (int i = 0; i < numItems; i++, src += Channels, dst += stride)
 	{
-		char* stream = src + (i * stride) + offset;
-
+		Word packed = 0;
 		for (int j = 0; j < Channels; j++)
-		{
-			int index = (i * Channels) + j;
-			float value = target[index];
+			packed |= (static_cast<Word>(quant[j](src[j])) & masks[j]) << shifts[j];
 
-			if (type == "snorm" || type == "sint")
-			{
-				int8_t pack = (type == "snorm") ? (value * ::getMaxIntValue(m_bits, true)) : value;
-				WriteSInt8(stream, pack);
-			}
-			else if (type == "unorm" || type == "uint")
-			{
-				uint8_t pack = (type == "unorm") ? (value * ::getMaxIntValue(m_bits, false)) : value;
-				WriteUInt8(stream, pack);
-			}
-		}
+		memcpy(dst, &packed, sizeof(Word));
 	}
 }
 
-void R10G10B10A2::updateData(INJ_DT_PARAMS)
-{
-	int channels = 4;
-	int numItems = size / channels;
+// ============================================
+// UPDATE FUNCTIONS
+// ============================================
 
-	for (int i = 0; i < numItems; i++)
-	{
-		char* stream = src + (i * stride) + offset;
+template <int Channels>
+void Format_32Bit<Channels>::updateData(INJ_DT_PARAMS)
+{
+	// 32-bit channels are written bit-for-bit - packed uint words are passed through as float bits
+	int numItems = size / Channels;
+	char* stream = src + offset;
 
-		uint32_t packedR = (target[(i * channels) + 0]);
-		uint32_t packedG = (target[(i * channels) + 1]);
-		uint32_t packedB = (target[(i * channels) + 2]);
-		uint32_t packedA = (target[(i * channels) + 3]);
+	for (int i = 0; i < numItems; i++, stream += stride)
+		memcpy(stream, &target[i * Channels], Channels * sizeof(float));
+}
 
-		uint32_t packedValue = (packedR & 0x3FF)
-			| ((packedG & 0x3FF) << 10)
-			| ((packedB & 0x3FF) << 20)
-			| ((packedA & 0x3) << 30);
+template <int Channels>
+void Format_16Bit<Channels>::updateData(INJ_DT_PARAMS)
+{
+	int numItems = size / Channels;
+	auto quant = ::getQuantType(type);
+	StQuantizer quantizer(quant, m_bits);
 
-		WriteUInt32(stream, packedValue);
-	}
+	if (quant == enQuantType::SNORM || quant == enQuantType::SINT)
+		::packChannels<int16_t, Channels>(src + offset, target.data(), numItems, stride, quantizer);
+	else if (quant == enQuantType::UNORM || quant == enQuantType::UINT)
+		::packChannels<uint16_t, Channels>(src + offset, target.data(), numItems, stride, quantizer);
 }
 
-void R10G10B10::updateData(INJ_DT_PARAMS)
+template <int Channels>
+void Format_8Bit<Channels>::updateData(INJ_DT_PARAMS)
 {
-	int channels = 3;
-	int numItems = size / channels;
-
-	for (int i = 0; i < numItems; i++)
-	{
-		char* stream = src + (i * stride) + offset;
+	int numItems = size / Channels;
+	auto quant = ::getQuantType(type);
+	StQuantizer quantizer(quant, m_bits);
 
-		uint32_t packedR = (target[(i * channels) + 0]);
-		uint32_t packedG = (target[(i * channels) + 1]);
-		uint32_t packedB = (target[(i * channels) + 2]);
+	if (quant == enQuantType::SNORM || quant == enQuantType::SINT)
+		::packChannels<int8_t, Channels>(src + offset, target.data(), numItems, stride, quantizer);
+	else if (quant == enQuantType::UNORM || quant == enQuantType::UINT)
+		::packChannels<uint8_t, Channels>(src + offset, target.data(), numItems, stride, quantizer);
+}
 
-		uint32_t packedValue = (packedR & 0x3FF)
-			| ((packedG & 0x3FF) << 10)
-			| ((packedB & 0x3FF) << 20);
+void R10G10B10A2::updateData(INJ_DT_PARAMS)
+{
+	auto quant = ::getQuantType(type);
+	const int bits[4]   = { 10, 10, 10, 2 };
+	const int shifts[4] = { 0, 10, 20, 30 };
+	const StQuantizer quantizer[4] = {
+		{ quant, 10 }, { quant, 10 }, { quant, 10 }, { quant, 2 } };
 
-		WriteUInt32(stream, packedValue);
-	}
+	::packBitfield<uint32_t, 4>(src + offset, target.data(), size / 4, stride, quantizer, bits, shifts);
 }
 
-void R11G11B10::updateData(INJ_DT_PARAMS)
+void R10G10B10::updateData(INJ_DT_PARAMS)
 {
-	int channels = 3;
-	int numItems = size / channels;
+	auto quant = ::getQuantType(type);
+	const int bits[3]   = { 10, 10, 10 };
+	const int shifts[3] = { 0, 10, 20 };
+	const StQuantizer quantizer[3] = { { quant, 10 }, { quant, 10 }, { quant, 10 } };
 
-	for (int i = 0; i < numItems; i++)
-	{
-		char* stream = src + (i * stride) + offset;
-
-		uint32_t packedR = (target[(i * channels) + 0]);
-		uint32_t packedG = (target[(i * channels) + 1]);
-		uint32_t packedB = (target[(i * channels) + 2]);
+	::packBitfield<uint32_t, 3>(src + offset, target.data(), size / 3, stride, quantizer, bits, shifts);
+}
 
-		uint32_t packedValue = (packedR & 0x7FF)        // 11 bits
-			| ((packedG & 0x7FF) << 11)  // 11 bits
-			| ((packedB & 0x3FF) << 22); // 10 bits
+void R11G11B10::updateData(INJ_DT_PARAMS)
+{
+	auto quant = ::getQuantType(type);
+	const int bits[3]   = { 11, 11, 10 };
+	const int shifts[3] = { 0, 11, 22 };
+	const StQuantizer quantizer[3] = { { quant, 11 }, { quant, 11 }, { quant, 10 } };
 
-		WriteUInt32(stream, packedValue);
-	}
+	::packBitfield<uint32_t, 3>(src + offset, target.data(), size / 3, stride, quantizer, bits, shifts);
 }
 
 void R21G21B22::updateData(INJ_DT_PARAMS)
 {
-	int channels = 3;
-	int numItems = size / channels;
-
-	for (int i = 0; i < numItems; i++)
-	{
-		char* stream = src + (i * stride) + offset;
-
-		float xVal = target[(i * channels) + 0];
-		float yVal = target[(i * channels) + 1];
-		float zVal = target[(i * channels) + 2];
-
-		uint64_t packedX, packedY, packedZ;
+	auto quant = ::getQuantType(type);
+	const int bits[3]   = { 21, 21, 22 };
+	const int shifts[3] = { 0, 21, 42 };
+	const StQuantizer quantizer[3] = { { quant, 21 }, { quant, 21 }, { quant, 22 } };
 
-		if (type == "snorm" || type == "sint")
-		{
-			packedX = static_cast<uint64_t>(static_cast<int64_t>(
-				(type == "snorm") ? (xVal * ::getMaxIntValue(21, true)) : xVal
-				)) & 0x1FFFFF;
-			packedY = static_cast<uint64_t>(static_cast<int64_t>(
-				(type == "snorm") ? (yVal * ::getMaxIntValue(21, true)) : yVal
-				)) & 0x1FFFFF;
-			packedZ = static_cast<uint64_t>(static_cast<int64_t>(
-				(type == "snorm") ? (zVal * ::getMaxIntValue(22, true)) : zVal
-				)) & 0x3FFFFF;
-		}
-		else if (type == "unorm" || type == "uint")
-		{
-			packedX = static_cast<uint64_t>(
-				(type == "unorm") ? (xVal * ::getMaxIntValue(21, false)) : xVal
-				) & 0x1FFFFF;
-			packedY = static_cast<uint64_t>(
-				(type == "unorm") ? (yVal * ::getMaxIntValue(21, false)) : yVal
-				) & 0x1FFFFF;
-			packedZ = static_cast<uint64_t>(
-				(type == "unorm") ? (zVal * ::getMaxIntValue(22, false)) : zVal
-				) & 0x3FFFFF;
-		}
-		else
-		{
-			packedX = static_cast<uint64_t>(xVal) & 0x1FFFFF;
-			packedY = static_cast<uint64_t>(yVal) & 0x1FFFFF;
-			packedZ = static_cast<uint64_t>(zVal) & 0x3FFFFF;
-		}
-
-		uint64_t packedValue = packedX | (packedY << 21) | (packedZ << 42);
-		WriteUInt64(stream, packedValue);
-	}
+	::packBitfield<uint64_t, 3>(src + offset, target.data(), size / 3, stride, quantizer, bits, shifts);
 }
 
 // ============================================
 // ENCODE FUNCTIONS
 // ============================================
 
-template <int Channels>
-char* Format_8Bit<Channels>::encode(EXP_DT_PARAMS)
+// Allocates a tightly packed stream and quantizes 'target' into it
+static char* encodeStream(Format* format, const std::vector<float>& target, const std::string& type, size_t& length)
 {
-	size_t size = target.size();
-	size_t stride = Channels * sizeof(int8_t);
-	length = (size / Channels) * stride;
-	char* stream = new char[length];
+	int numItems = target.size() / format->get_channels();
+	int stride = format->get_size(1);
+	length = static_cast<size_t>(numItems) * stride;
 
-	this->updateData(stream, size, target, type, 0, stride);
+	char* stream = new char[length];
+	format->updateData(stream, target.size(), target, type, 0, stride);
 	return stream;
 }
 
 template <int Channels>
-char* Format_16Bit<Channels>::encode(EXP_DT_PARAMS)
+char* Format_8Bit<Channels>::encode(EXP_DT_PARAMS)
 {
-	size_t size = target.size();
-	size_t stride = Channels * sizeof(int16_t);
-	length = (size / Channels) * stride;
-	char* stream = new char[length];
+	return ::encodeStream(this, target, type, length);
+}
 
-	this->updateData(stream, size, target, type, 0, stride);
-	return stream;
+template <int Channels>
+char* Format_16Bit<Channels>::encode(EXP_DT_PARAMS)
+{
+	return ::encodeStream(this, target, type, length);
 }
 
 template <int Channels>
 char* Format_32Bit<Channels>::encode(EXP_DT_PARAMS)
 {
-	size_t size = target.size();
-	size_t stride = Channels * sizeof(int32_t);
-	length = (size / Channels) * stride;
-	char* stream = new char[length];
-
-	this->updateData(stream, size, target, type, 0, stride);
-	return stream;
+	return ::encodeStream(this, target, type, length);
 }
 
 char* R10G10B10A2::encode(EXP_DT_PARAMS)
 {
-	size_t size = target.size();
-	size_t stride = sizeof(int32_t);
-	length = (size / get_channels()) * stride;
-	char* stream = new char[length];
-
-	this->updateData(stream, size, target, type, 0, stride);
-	return stream;
+	return ::encodeStream(this, target, type, length);
 }
 
 char* R10G10B10::encode(EXP_DT_PARAMS)
 {
-	size_t size = target.size();
-	size_t stride = sizeof(int32_t);
-	length = (size / get_channels()) * stride;
-	char* stream = new char[length];
-
-	this->updateData(stream, size, target, type, 0, stride);
-	return stream;
+	return ::encodeStream(this, target, type, length);
 }
 
 char* R11G11B10::encode(EXP_DT_PARAMS)
 {
-	size_t size = target.size();
-	size_t stride = sizeof(int32_t);
-	length = (size / get_channels()) * stride;
-	char* stream = new char[length];
-
-	this->updateData(stream, size, target, type, 0, stride);
-	return stream;
+	return ::encodeStream(this, target, type, length);
 }
 
 char* R21G21B22::encode(EXP_DT_PARAMS)
 {
-	size_t size = target.size();
-	size_t stride = sizeof(uint64_t);
-	length = (size / get_channels()) * stride;
-	char* stream = new char[length];
-
-	this->updateData(stream, size, target, type, 0, stride);
-	return stream;
-}
\ No newline at end of file
+	return ::encodeStream(this, target, type, length);
+}
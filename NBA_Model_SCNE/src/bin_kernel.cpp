@@ -0,0 +1,373 @@
+#include <bin_kernel.h>
+#include <common.h>
+#include <bin_codec.h>
+#include <threadpool.h>
+#include <cstring>
+#include <cmath>
+
+/* Packed element readers - each unpacks one strided element into normalized floats */
+
+template <int Channels>
+struct ReadFloat32
+{
+	static constexpr int channels = Channels;
+	static constexpr int size     = Channels * sizeof(float);
+
+	inline void operator()(const char* data, float* v) const {
+		memcpy(v, data, size);
+	}
+};
+
+template <int Channels, typename T>
+struct ReadInt16
+{
+	static constexpr int channels = Channels;
+	static constexpr int size     = Channels * sizeof(T);
+	float norm = 1.0f;
+
+	inline void operator()(const char* data, float* v) const {
+		T raw[Channels];
+		memcpy(raw, data, size);
+		for (int j = 0; j < Channels; j++)
+			v[j] = static_cast<float>(raw[j]) * norm;
+	}
+};
+
+struct ReadR21G21B22
+{
+	static constexpr int channels = 3;
+	static constexpr int size     = sizeof(uint64_t);
+	float norm[3] = { 1.0f, 1.0f, 1.0f };
+
+	inline void operator()(const char* data, float* v) const {
+		uint64_t packed;
+		memcpy(&packed, data, size);
+		v[0] = static_cast<float>((packed >> 0)  & 0x1FFFFF) * norm[0];
+		v[1] = static_cast<float>((packed >> 21) & 0x1FFFFF) * norm[1];
+		v[2] = static_cast<float>((packed >> 42) & 0x3FFFFF) * norm[2];
+	}
+};
+
+static inline float getNormScale(const int bits, const std::string& type)
+{
+	// Matches the 'unpackValue' semantics of the generic codec
+	if (common::containsSubstring(type, "snorm"))
+		return 1.0f / static_cast<float>((1ULL << (bits - 1)) - 1);
+	if (common::containsSubstring(type, "unorm"))
+		return 1.0f / static_cast<float>((1ULL << bits) - 1);
+	return 1.0f;
+}
+
+// Resolves a packed reader for the format string and hands it to 'fn'. Returns false if unsupported.
+template <typename Fn>
+static bool withReader(const std::string& format, Fn&& fn)
+{
+	auto parts = common::splitString(format, '_');
+	if (parts.empty())
+		return false;
+
+	const std::string& encoding = parts.front();
+	const std::string  type     = common::to_lower(parts.back());
+	bool isSigned = (type == "snorm" || type == "sint");
+	bool isUnsigned = (type == "unorm" || type == "uint");
+
+	if (encoding == "R32G32B32A32" && type == "float") { fn(ReadFloat32<4>{}); return true; }
+	if (encoding == "R32G32B32" && type == "float")    { fn(ReadFloat32<3>{}); return true; }
+	if (encoding == "R32G32" && type == "float")       { fn(ReadFloat32<2>{}); return true; }
+
+	if (encoding == "R16G16B16A16" || encoding == "R16G16B16" || encoding == "R16G16")
+	{
+		if (!isSigned && !isUnsigned)
+			return false;
+
+		float norm = ::getNormScale(16, type);
+		if (encoding == "R16G16B16A16")
+			(isSigned) ? fn(ReadInt16<4, int16_t>{ norm }) : fn(ReadInt16<4, uint16_t>{ norm });
+		else if (encoding == "R16G16B16")
+			(isSigned) ? fn(ReadInt16<3, int16_t>{ norm }) : fn(ReadInt16<3, uint16_t>{ norm });
+		else
+			(isSigned) ? fn(ReadInt16<2, int16_t>{ norm }) : fn(ReadInt16<2, uint16_t>{ norm });
+		return true;
+	}
+
+	if (encoding == "R21G21B22")
+	{
+		ReadR21G21B22 reader;
+		reader.norm[0] = ::getNormScale(21, type);
+		reader.norm[1] = ::getNormScale(21, type);
+		reader.norm[2] = ::getNormScale(22, type);
+		fn(reader);
+		return true;
+	}
+
+	return false;
+}
+
+/* Kernels */
+
+template <int NumOut, typename Reader>
+static void positionKernel(const char* data, const size_t items, const uint32_t stride,
+	const Reader& read, const StAttribTfm& tfm, float* dst)
+{
+	const auto& m = tfm.axis;
+	const float* s = tfm.scale;
+	const float* o = tfm.offset;
+
+	for (size_t i = 0; i < items; i++, data += stride, dst += NumOut)
+	{
+		float v[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+		read(data, v);
+
+		// dequantize
+		const float x = (v[0] * s[0]) + o[0];
+		const float y = (v[1] * s[1]) + o[1];
+		const float z = (v[2] * s[2]) + o[2];
+
+		// axis convert
+		dst[0] = (m[0][0] * x) + (m[0][1] * y) + (m[0][2] * z);
+		dst[1] = (m[1][0] * x) + (m[1][1] * y) + (m[1][2] * z);
+		dst[2] = (m[2][0] * x) + (m[2][1] * y) + (m[2][2] * z);
+
+		if constexpr (NumOut == 4)
+			dst[3] = (v[3] * s[3]) + o[3];
+	}
+}
+
+template <typename Reader>
+static void texcoordKernel(const char* data, const size_t items, const uint32_t stride,
+	const Reader& read, const StAttribTfm& tfm, float* dst)
+{
+	const float* s = tfm.scale;
+	const float* o = tfm.offset;
+	const float flipSign = (tfm.flipV) ? -1.0f : 1.0f;
+	const float flipBase = (tfm.flipV) ?  1.0f : 0.0f;
+
+	for (size_t i = 0; i < items; i++, data += stride, dst += 2)
+	{
+		float v[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		read(data, v);
+
+		dst[0] = (v[0] * s[0]) + o[0];
+		dst[1] = flipBase + flipSign * ((v[1] * s[1]) + o[1]);
+	}
+}
+
+template <bool Signed, bool WithSigns>
+static void tangentFrameKernel(const char* data, const size_t items, const uint32_t stride,
+	float* normals, float* signs)
+{
+	for (size_t i = 0; i < items; i++, data += stride, normals += 3)
+	{
+		uint32_t packed;
+		memcpy(&packed, data, sizeof(uint32_t));
+
+		// unpack octahedral XY to [-1, 1]
+		float x, y;
+		if constexpr (Signed) {
+			const int32_t r = static_cast<int32_t>(packed << 22) >> 22;
+			const int32_t g = static_cast<int32_t>(packed << 12) >> 22;
+			x = fmaxf(static_cast<float>(r) * (1.0f / 511.0f), -1.0f);
+			y = fmaxf(static_cast<float>(g) * (1.0f / 511.0f), -1.0f);
+		}
+		else {
+			x = (static_cast<float>((packed >> 0)  & 0x3FF) * (2.0f / 1023.0f)) - 1.0f;
+			y = (static_cast<float>((packed >> 10) & 0x3FF) * (2.0f / 1023.0f)) - 1.0f;
+		}
+
+		// octahedral decode - branchless so the loop stays vectorizable
+		const float z = 1.0f - fabsf(x) - fabsf(y);
+		const float t = fmaxf(-z, 0.0f);
+		x -= copysignf(t, x);
+		y -= copysignf(t, y);
+
+		const float len = sqrtf((x * x) + (y * y) + (z * z));
+		const float inv = (len > 0.0f) ? (1.0f / len) : 1.0f;
+		normals[0] = x * inv;
+		normals[1] = y * inv;
+		normals[2] = z * inv;
+
+		// high alpha bit stores the tangent handedness - resolved at compile time, no test in the loop
+		if constexpr (WithSigns)
+			signs[i] = (packed >> 31) ? -1.0f : 1.0f;
+	}
+}
+
+static bool getFrameEncoding(const std::string& format, bool& isSigned)
+{
+	isSigned = (format == "R10G10B10_SNORM_A2_UNORM");
+	return isSigned || (format == "R10G10B10A2_UINT");
+}
+
+// Splits large streams across the shared thread pool - small ones run inline
+template <typename Fn>
+static void forEachChunk(const size_t items, Fn&& fn)
+{
+	if (items < DECODE_PARALLEL_ITEMS)
+		return fn(0, items);
+
+	CThreadPool::instance().parallelFor(items, DECODE_CHUNK_ITEMS, DECODE_PARALLEL_ITEMS, fn);
+}
+
+void StAttribTfm::setScaleOffset(const std::pmr::vector<float>& tfmScale, const std::pmr::vector<float>& tfmOffset)
+{
+	// Only apply transforms when the buffer defines both - same as the generic path
+	if (tfmScale.empty() || tfmOffset.empty())
+		return;
+
+	for (size_t i = 0; i < 4; i++)
+	{
+		scale[i]  = (i < tfmScale.size())  ? tfmScale[i]  : 1.0f;
+		offset[i] = (i < tfmOffset.size()) ? tfmOffset[i] : 0.0f;
+	}
+}
+
+StAttribTfm BinKernel::positionTfm(const std::string& format)
+{
+	StAttribTfm tfm;
+	tfm.kernel = enAttribKernel::POSITION;
+
+	// Ball meshes keep XYZW and are already positioned by their scale/offset
+	if (format == "R16G16B16A16_SNORM")
+	{
+		tfm.components = 4;
+		return tfm;
+	}
+
+	// NBA to Blender (Y-up -> Z-up): (x, y, z) -> (x, -z, y)
+	float basis[3][3] = { { 1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, -1.0f }, { 0.0f, 1.0f, 0.0f } };
+	memcpy(tfm.axis, basis, sizeof(basis));
+	tfm.components = 3;
+	tfm.toBlender  = true;
+	return tfm;
+}
+
+StAttribTfm BinKernel::texcoordTfm()
+{
+	StAttribTfm tfm;
+	tfm.kernel     = enAttribKernel::TEXCOORD;
+	tfm.components = 2;
+	tfm.flipV      = true;
+	return tfm;
+}
+
+StAttribTfm BinKernel::tangentFrameTfm()
+{
+	StAttribTfm tfm;
+	tfm.kernel     = enAttribKernel::TANGENTFRAME;
+	tfm.components = 3;
+	return tfm;
+}
+
+int BinKernel::elementSize(const std::string& format)
+{
+	bool isSigned;
+	if (::getFrameEncoding(format, isSigned))
+		return sizeof(uint32_t);
+
+	int size = 0;
+	::withReader(format, [&](const auto& reader) { size = reader.size; });
+	return size;
+}
+
+bool BinKernel::supports(const StAttribTfm& tfm, const std::string& format)
+{
+	bool isSigned;
+	if (tfm.kernel == enAttribKernel::TANGENTFRAME)
+		return ::getFrameEncoding(format, isSigned);
+
+	int channels = 0;
+	if (!::withReader(format, [&](const auto& reader) { channels = reader.channels; }))
+		return false;
+
+	switch (tfm.kernel)
+	{
+	case enAttribKernel::POSITION:
+		return (channels >= 3);
+	case enAttribKernel::TEXCOORD:
+		return (channels >= 2);
+	default:
+		return false;
+	}
+}
+
+bool BinKernel::decode(
+	const char* src,
+	const size_t items,
+	const uint64_t offset,
+	const uint32_t stride,
+	const std::string& format,
+	const StAttribTfm& tfm,
+	std::vector<float>& target)
+{
+	if (!src || !BinKernel::supports(tfm, format))
+		return false;
+
+	if (tfm.kernel == enAttribKernel::TANGENTFRAME)
+		return BinKernel::decodeTangentFrames(src, items, offset, stride, format, target);
+
+	target.resize(items * tfm.components);
+	float* dst = target.data();
+
+	return ::withReader(format, [&](const auto& reader)
+		{
+			uint32_t elemStride = (stride > 0) ? stride : reader.size;
+			const char* data = src + offset;
+
+			::forEachChunk(items, [&](size_t begin, size_t end)
+				{
+					const char* chunkData = data + (begin * elemStride);
+					float* chunkDst = dst + (begin * tfm.components);
+
+					// Output width is a template argument so the XYZW test stays out of the loop
+					if (tfm.kernel == enAttribKernel::POSITION && tfm.components == 4)
+						::positionKernel<4>(chunkData, end - begin, elemStride, reader, tfm, chunkDst);
+					else if (tfm.kernel == enAttribKernel::POSITION)
+						::positionKernel<3>(chunkData, end - begin, elemStride, reader, tfm, chunkDst);
+					else
+						::texcoordKernel(chunkData, end - begin, elemStride, reader, tfm, chunkDst);
+				});
+		});
+}
+
+bool BinKernel::decodeTangentFrames(
+	const char* src,
+	const size_t items,
+	const uint64_t offset,
+	const uint32_t stride,
+	const std::string& format,
+	std::vector<float>& normals,
+	std::vector<float>* signs)
+{
+	bool isSigned;
+	if (!src || !::getFrameEncoding(format, isSigned))
+		return false;
+
+	normals.resize(items * 3);
+	if (signs)
+		signs->resize(items);
+
+	const char* data = src + offset;
+	uint32_t elemStride = (stride > 0) ? stride : sizeof(uint32_t);
+	float* signData = (signs) ? signs->data() : nullptr;
+
+	float* normalData = normals.data();
+
+	::forEachChunk(items, [&](size_t begin, size_t end)
+		{
+			const char* chunkData = data + (begin * elemStride);
+			float* chunkSigns = (signData) ? signData + begin : nullptr;
+
+			float* chunkNormals = normalData + (begin * 3);
+			size_t count = end - begin;
+
+			if (isSigned && chunkSigns)
+				::tangentFrameKernel<true, true>(chunkData, count, elemStride, chunkNormals, chunkSigns);
+			else if (isSigned)
+				::tangentFrameKernel<true, false>(chunkData, count, elemStride, chunkNormals, nullptr);
+			else if (chunkSigns)
+				::tangentFrameKernel<false, true>(chunkData, count, elemStride, chunkNormals, chunkSigns);
+			else
+				::tangentFrameKernel<false, false>(chunkData, count, elemStride, chunkNormals, nullptr);
+		});
+	return true;
+}
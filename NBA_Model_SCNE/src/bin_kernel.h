@@ -0,0 +1,60 @@
+/* Fused vertex decode kernels - unpack, dequantize and axis convert packed attributes in a single pass */
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <memory_resource>
+#pragma once
+
+enum class enAttribKernel
+{
+	NONE,
+	POSITION,
+	TEXCOORD,
+	TANGENTFRAME
+};
+
+// Per-buffer transform applied while decoding: out = axis * ((raw * scale) + offset)
+struct StAttribTfm
+{
+	enAttribKernel kernel = enAttribKernel::NONE;
+
+	float scale[4]   = { 1.0f, 1.0f, 1.0f, 1.0f };
+	float offset[4]  = { 0.0f, 0.0f, 0.0f, 0.0f };
+	float axis[3][3] = { { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f } };
+
+	int  components = 3;      // output floats per element (3 = XYZ, 4 = XYZW)
+	bool flipV      = false;  // texcoords: V -> 1 - V
+	bool toBlender  = false;  // axis holds the NBA (Y-up) to Blender (Z-up) basis
+
+	void setScaleOffset(const std::pmr::vector<float>& scale, const std::pmr::vector<float>& offset);
+};
+
+namespace BinKernel
+{
+	StAttribTfm positionTfm(const std::string& format);
+	StAttribTfm texcoordTfm();
+	StAttribTfm tangentFrameTfm();
+
+	bool supports(const StAttribTfm& tfm, const std::string& format);
+	int  elementSize(const std::string& format);
+
+	bool decode(
+		const char* src,
+		const size_t items,
+		const uint64_t offset,
+		const uint32_t stride,
+		const std::string& format,
+		const StAttribTfm& tfm,
+		std::vector<float>& target);
+
+	// Packed octahedral frames (R10G10B10A2_UINT / R10G10B10_SNORM_A2_UNORM) -> unit normals (+ optional tangent sign)
+	bool decodeTangentFrames(
+		const char* src,
+		const size_t items,
+		const uint64_t offset,
+		const uint32_t stride,
+		const std::string& format,
+		std::vector<float>& normals,
+		std::vector<float>* signs = nullptr);
+}
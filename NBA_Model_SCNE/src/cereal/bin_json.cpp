@@ -2,6 +2,10 @@
 #include <datastream.h>
 #include <bin_codec.h>
 #include <common.h>
+#include <algorithm>
+#include <cmath>
+#include <cfloat>
+#include <iterator>
 
 std::string BinJSON::generateBufferID(const Mesh& mesh, const char* stream_id, const int enum_type)
 {
@@ -78,6 +82,128 @@ BinJSON::createPackedVertexSkinBuffer
 	fmtObj["WEIGHTDATA0"]     = wgtFmtInfo;
 }
 
+// Position formats the reader dequantizes with the buffer's Scale/Offset
+struct StPositionFormat
+{
+	const char* format;
+	const char* type;
+	int  stride;
+	int  channels;
+	int  bits[3];
+	bool isSigned;
+};
+
+// XYZW meshes keep W and skip the axis swap on import, so each vertex layout has its own candidates - smallest first
+static const StPositionFormat XYZ_POSITION_FORMATS[]  = { { "R21G21B22", "UINT", 8, 3, { 21, 21, 22 }, false } };
+static const StPositionFormat XYZW_POSITION_FORMATS[] = { { "R16G16B16A16", "SNORM", 8, 4, { 16, 16, 16 }, true } };
+
+// Quantizes XYZ with a tight per-axis fit, returns the largest reconstruction error
+static float quantizePositionFmt(const std::vector<float>& xyzw, const StPositionFormat& fmt,
+	std::vector<float>& dst, std::vector<float>& scale, std::vector<float>& offset)
+{
+	size_t numVerts = xyzw.size() / 4;
+	float lo[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+	float hi[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+	for (size_t i = 0; i < numVerts; i++)
+		for (int c = 0; c < 3; c++) {
+			lo[c] = std::min(lo[c], xyzw[i * 4 + c]);
+			hi[c] = std::max(hi[c], xyzw[i * 4 + c]);
+		}
+
+	// decoded = raw * norm * scale + offset - matches CDataBuffer / BinKernel
+	float norm[3];
+	float maxRaw[3];
+	scale.assign({ 1.0f, 1.0f, 1.0f, 1.0f });
+	offset.assign({ 0.0f, 0.0f, 0.0f, 0.0f });
+
+	for (int c = 0; c < 3; c++)
+	{
+		float extent = hi[c] - lo[c];
+		maxRaw[c] = static_cast<float>((1ULL << (fmt.bits[c] - fmt.isSigned)) - 1);
+		norm[c]   = (fmt.isSigned) ? 1.0f / maxRaw[c] : 1.0f;
+		offset[c] = (fmt.isSigned) ? lo[c] + (extent * 0.5f) : lo[c];
+		scale[c]  = (extent > 0.0f) ? ((fmt.isSigned) ? extent * 0.5f : extent / maxRaw[c]) : 1.0f;
+	}
+
+	dst.resize(numVerts * fmt.channels);
+	float maxError = 0.0f;
+
+	for (size_t i = 0; i < numVerts; i++)
+	{
+		for (int c = 0; c < 3; c++)
+		{
+			float value = xyzw[i * 4 + c];
+			float codec = (value - offset[c]) / scale[c];
+			dst[i * fmt.channels + c] = codec;
+
+			// Same clamp and round to nearest as the codec's quantizer
+			float raw = std::min(std::max(codec / norm[c], (fmt.isSigned) ? -maxRaw[c] : 0.0f), maxRaw[c]);
+			raw = std::round(raw);
+			maxError = std::max(maxError, std::abs((raw * norm[c] * scale[c] + offset[c]) - value));
+		}
+
+		if (fmt.channels == 4)
+			dst[i * 4 + 3] = xyzw[i * 4 + 3];
+	}
+
+	return maxError;
+}
+
+bool
+BinJSON::quantizePositions(const Mesh& mesh, VertexStream& vs, std::vector<float>& dst, const float maxError)
+{
+	// Expects the XYZW stream written by the model serializer
+	if (!vs.data || vs.data->empty() || vs.data->size() % 4 != 0 || maxError <= 0.0f)
+		return false;
+
+	bool isXYZW = (mesh.vertexComponents == 4);
+	auto* formats = (isXYZW) ? XYZW_POSITION_FORMATS : XYZ_POSITION_FORMATS;
+	size_t numFormats = (isXYZW) ? std::size(XYZW_POSITION_FORMATS) : std::size(XYZ_POSITION_FORMATS);
+
+	for (size_t i = 0; i < numFormats; i++)
+	{
+		auto& fmt = formats[i];
+		float error = ::quantizePositionFmt(*vs.data, fmt, dst, vs.scale, vs.offset);
+
+		if (error <= maxError)
+		{
+			printf("\n[BinJSON] %s: %s_%s positions (%d bytes/vertex), max error %g",
+				mesh.name.c_str(), fmt.format, fmt.type, fmt.stride, error);
+
+			vs.format = fmt.format;
+			vs.type   = fmt.type;
+			return true;
+		}
+
+		printf("\n[BinJSON] %s: %s_%s exceeds error bound (%g > %g)",
+			mesh.name.c_str(), fmt.format, fmt.type, error, maxError);
+	}
+
+	// Keep the float stream
+	dst.clear();
+	vs.scale.clear();
+	vs.offset.clear();
+	return false;
+}
+
+static JSON getVertexFormatJson(const VertexStream& vs, const int index, const int byteOffset)
+{
+	JSON fmtInfo;
+	fmtInfo["Format"] = vs.format + "_" + vs.type;
+	fmtInfo["Stream"] = index;
+
+	if (byteOffset >= 0)
+		fmtInfo["ByteOffset"] = byteOffset;
+
+	if (!vs.scale.empty() && !vs.offset.empty()) {
+		fmtInfo["Offset"] = vs.offset;
+		fmtInfo["Scale"]  = vs.scale;
+	}
+
+	return fmtInfo;
+}
+
 void
 BinJSON::createVertexBuffer
 (
@@ -99,18 +225,85 @@ BinJSON::createVertexBuffer
 	BinJSON::writeVertexBuffer(vs);
 
 	// Define vertex buffer format
-	JSON fmtInfo, stream;
-	fmtInfo["Format"] = vs.format + "_" + vs.type;
-	fmtInfo["Stream"] = index;
+	fmtObj[vs.name] = ::getVertexFormatJson(vs, index, -1);
 
 	// Define vertex buffer stream
+	JSON stream;
 	stream["Stride"] = vs.stride;
 	stream["Size"]   = vs.size;
 	stream["Binary"] = std::string(subdir) + vs.file_name;
-	fmtObj[vs.name]  = fmtInfo;
 	srmObj["VertexBuffer_" + std::to_string(index)] = stream;
 }
 
+void
+BinJSON::createInterleavedVertexBuffer
+(
+	const std::vector<VertexStream*>& streams,
+	const char* dirPath,
+	const char* subdir,
+	const Mesh& mesh,
+	JSON& fmtObj,
+	JSON& srmObj,
+	const int index
+)
+{
+	// Element layout - attributes follow each other in stream order
+	std::vector<VertexStream*> layout;
+	std::vector<VertexStream*> separate; // element count differs from the layout - written as their own streams
+	std::vector<uint32_t> offsets;
+	uint32_t stride = 0;
+	size_t numVerts = 0;
+
+	for (auto& vs : streams)
+	{
+		if (!vs || !vs->data || vs->data->empty())
+			continue;
+
+		BinaryCodec codec(vs->format, vs->type);
+		size_t items = vs->data->size() / codec.num_channels();
+		if (!layout.empty() && items != numVerts) {
+			printf("\n[BinJSON] WARNING: %s has %zu elements, expected %zu - exported as a separate stream", vs->name.c_str(), items, numVerts);
+			separate.push_back(vs);
+			continue;
+		}
+
+		numVerts = items;
+		vs->stride = codec.size(1);
+		layout.push_back(vs);
+		offsets.push_back(stride);
+		stride += static_cast<uint32_t>(vs->stride);
+	}
+
+	if (layout.empty())
+		return;
+
+	// Quantize every attribute straight into its slot of the shared element
+	std::vector<char> buffer(numVerts * stride, 0);
+	for (size_t i = 0; i < layout.size(); i++)
+	{
+		auto& vs = *layout[i];
+		char* dst = buffer.data();
+
+		BinaryCodec codec(vs.format, vs.type);
+		codec.update(dst, static_cast<int>(vs.data->size()), *vs.data, offsets[i], stride);
+		fmtObj[vs.name] = ::getVertexFormatJson(vs, index, offsets[i]);
+	}
+
+	std::string fileName = generateBufferID(mesh, "INTERLEAVED", 0);
+	CDataStream::writeDataToFile(std::string(dirPath) + "/" + std::string(subdir) + fileName, buffer.data(), buffer.size());
+
+	JSON stream;
+	stream["Stride"] = stride;
+	stream["Size"]   = buffer.size();
+	stream["Binary"] = std::string(subdir) + fileName;
+	srmObj["VertexBuffer_" + std::to_string(index)] = stream;
+
+	// Streams that can't share the element follow the interleaved one
+	int streamIndex = index;
+	for (auto& vs : separate)
+		BinJSON::createVertexBuffer(*vs, dirPath, subdir, mesh, fmtObj, srmObj, ++streamIndex);
+}
+
 void
 BinJSON::writeIndexBuffer(VertexStream& vs)
 {
@@ -20,6 +20,8 @@ struct VertexStream
 	std::string file_path;
 	size_t size = 0;
 	size_t stride = 0;
+	std::vector<float> scale;  // dequantize transform per channel - written as Scale/Offset when set
+	std::vector<float> offset;
 
 	std::vector<float>* data;
 	void* index_data;
@@ -50,6 +52,24 @@ namespace BinJSON
 		JSON& srmObj,
 		const int index);
 
+	// Picks the smallest quantized position format within 'maxError' - fills 'dst' with codec space XYZ(W)
+	bool quantizePositions(
+		const Mesh& mesh,
+		VertexStream& vs,
+		std::vector<float>& dst,
+		const float maxError);
+
+	// Packs all streams into one binary (single file, one write) with per attribute ByteOffset.
+	// Streams whose element count differs from the first one are written as separate streams after it
+	void createInterleavedVertexBuffer(
+		const std::vector<VertexStream*>& streams,
+		const char* dirPath,
+		const char* subdir,
+		const Mesh& mesh,
+		JSON& fmtObj,
+		JSON& srmObj,
+		const int index);
+
 	void createVertexBuffer(
 		VertexStream& vertexBuffer,
 		const char* dirPath,
@@ -3,6 +3,7 @@
 #include <bin_codec.h>
 #include <datastream.h>
 #include <common.h>
+#include <meshprimitive.h>
 
 void
 MeshJSON::AABBsToJson(const std::shared_ptr<Mesh>& mesh, std::shared_ptr<JSON>& json)
@@ -45,6 +46,15 @@ MeshJSON::primsToJson(const std::shared_ptr<Mesh>& mesh, std::shared_ptr<JSON>&
 	(*prims)["Type"]     = "TRIANGLE_LIST";
 	(*prims)["Count"]    = mesh->triangles.size() * 3;
 
+	if (!mesh->lods.empty())
+	{
+		JSON lodList = JSON::array();
+		for (auto& lod : mesh->lods)
+			lodList.push_back({ { "Start", lod.begin }, { "Count", lod.count } });
+
+		(*prims)["LodList"] = lodList;
+	}
+
 	//MeshJSON::AABBsToJson(mesh, prims);
 	//MeshJSON::dUVsToJson(mesh, prims);
 	MeshJSON::skinDataToJson(mesh, prims);
@@ -87,10 +97,22 @@ MeshJSON::vertexDataToJson(const char* save_directory, const char* subdir, const
 	tangent.fromMesh(mesh);
 	texcoord.fromMesh(mesh);
 
+	// Quantized positions with a tight Scale/Offset when they fit the error bound
+	std::vector<float> quantized;
+	if (BinJSON::quantizePositions(*mesh, position, quantized, POSITION_MAX_ERROR))
+		position.data = &quantized;
+
 	// serialize vertex data
-	BinJSON::createVertexBuffer(position, save_directory, subdir, *mesh, *formatObj, *streamObj, 0);
-	BinJSON::createVertexBuffer(tangent, save_directory, subdir, *mesh, *formatObj, *streamObj, 1);
-	BinJSON::createVertexBuffer(texcoord, save_directory, subdir, *mesh, *formatObj, *streamObj, 2);
+	if (INTERLEAVE_VERTEX_STREAMS)
+	{
+		BinJSON::createInterleavedVertexBuffer({ &position, &tangent, &texcoord }, save_directory, subdir, *mesh, *formatObj, *streamObj, 0);
+	}
+	else
+	{
+		BinJSON::createVertexBuffer(position, save_directory, subdir, *mesh, *formatObj, *streamObj, 0);
+		BinJSON::createVertexBuffer(tangent, save_directory, subdir, *mesh, *formatObj, *streamObj, 1);
+		BinJSON::createVertexBuffer(texcoord, save_directory, subdir, *mesh, *formatObj, *streamObj, 2);
+	}
 
 	(*json)["VertexFormat"] = *formatObj;
 	(*json)["VertexStream"] = *streamObj;
@@ -104,7 +126,15 @@ MeshJSON::indexDataToJson(const char* dirPath, const char* subdir, const std::sh
 
 	VertexStream indices{ "INDEX", (is32Bit ? "R32" : "R16"), "UINT" };
 
-	indices.index_data = &mesh->triangles;
+	// LOD levels follow the full mesh in the same index buffer
+	std::vector<Triangle> lodChain;
+	if (!mesh->lodTriangles.empty()) {
+		lodChain.reserve(mesh->triangles.size() + mesh->lodTriangles.size());
+		lodChain.insert(lodChain.end(), mesh->triangles.begin(), mesh->triangles.end());
+		lodChain.insert(lodChain.end(), mesh->lodTriangles.begin(), mesh->lodTriangles.end());
+	}
+
+	indices.index_data = (lodChain.empty()) ? &mesh->triangles : &lodChain;
 	indices.file_name  = BinJSON::generateBufferID(*mesh, "INDEX", 1);
 	indices.file_path  = std::string(dirPath) + "/" + std::string(subdir) + indices.file_name;
 	BinJSON::writeIndexBuffer(indices);
@@ -4,8 +4,12 @@
 #include <cereal/mesh_json.h>
 #include <cereal/skin_json.h>
 #include <common.h>
+#include <meshprimitive.h>
+#include <meshopt.h>
+#include <meshlod.h>
 #include <armature/armature.h>
 #include <morphs/debug_morphs.h>
+#include <morphs/morphset.h>
 
 CModelSerializer::CModelSerializer(CSceneSerializer* parent)
 	:
@@ -31,7 +35,7 @@ CModelSerializer::setRigJson(const std::shared_ptr<CNBAModel>& model, std::share
 {
 	CSkeletonSerializer worker(m_parent);
 	auto tfmJson  = worker.serialize();
-	int numJoints = model->getSkeleton().joints.size();
+	int numJoints = model->getSkeleton().size();
 
 	(*root)["WeightBits"]      = 16;
 	(*root)["BlendIndexRange"] = std::vector<int>{ 0, numJoints };
@@ -41,11 +45,29 @@ CModelSerializer::setRigJson(const std::shared_ptr<CNBAModel>& model, std::share
 void
 CModelSerializer::addModelJson(const std::shared_ptr<CNBAModel>& model)
 {
+	// tangent space for meshes built from client data - all meshes at once so they run in parallel
+	std::vector<Mesh*> pending;
+	for (auto& mesh : model->getMeshes())
+		if (mesh->tangent_frames.empty() && !mesh->normals.empty())
+			pending.push_back(mesh.get());
+
+	MeshCalc::calculateTangentsBinormals(pending);
+	for (auto& mesh : pending)
+		MeshCalc::buildTangentFrameVec(*mesh, mesh->tangent_frames);
+
 	// collect mesh childs
 	for (auto& mesh : model->getMeshes()) 
 	{
-		// format mesh data
-		Mesh::createWAxis(mesh->vertices);
+		// optional cache/fetch ordering - must run before the W axis changes the vertex stride
+		if (OPTIMIZE_VERTEX_ORDER)
+			MeshOpt::optimizeMesh(*mesh);
+
+		// lower detail index ranges over the same vertices
+		MeshLod::buildLodChain(*mesh, LOD_RATIOS);
+
+		// format mesh data - XYZW meshes already carry W
+		if (mesh->vertexComponents != 4)
+			Mesh::createWAxis(mesh->vertices);
 		Mesh::createWAxis(mesh->normals);
 
 		// push mesh data to json
@@ -106,9 +128,16 @@ CModelSerializer::setMeshMorphs(std::shared_ptr<JSON>& json, const std::shared_p
 {
 	JSON morphs;
 
-	for (auto& morph : debugMorphs)
+	// Keep the source model's target names, the debug list covers meshes created in Blender
+	if (mesh->morphs && mesh->morphs->size())
+	{
+		for (size_t i = 0; i < mesh->morphs->size(); i++)
+			morphs[mesh->morphs->getName(int(i))] = nullptr;
+	}
+	else
 	{
-		morphs[morph] = nullptr;
+		for (auto& morph : debugMorphs)
+			morphs[morph] = nullptr;
 	}
 
 	(*json)["Morph"] = morphs;
@@ -34,11 +34,10 @@ void CObjectSerializer::processModel(const std::shared_ptr<CNBAModel>& model)
 		this->processMesh(mesh);
 
 
-		if (!armature.joints.empty() && !mesh->skin.blendverts.empty())
+		if (!armature.empty() && !mesh->skin.empty())
 		{
 			JSON& mdlJson = (*m_json)[mesh->name];
-			auto& bone = armature.joints.front();
-			mdlJson["Transform"] = bone->name;
+			mdlJson["Transform"] = armature.getName(0);
 		}
 	}
 }
@@ -18,43 +18,43 @@ CSkeletonSerializer::serialize()
 		return m_json;
 	
 	// Get root skeleton
-	auto skeleton = scene->models().front()->getSkeleton();
+	auto& skeleton = scene->models().front()->getSkeleton();
 	this->generateTransforms(m_json, skeleton);
 
 	return m_json;
 }
 
-inline static int findFirstChild(
-	const std::string& target,
-	const std::vector<std::shared_ptr<NSJoint>>& joints,
-	const int ignore_index = -1)
+void
+CSkeletonSerializer::generateTransforms(std::shared_ptr<JSON> json, NSSkeleton& skeleton)
 {
-	for (int i = 0; i < joints.size(); i++)
-	{
-		auto& joint = joints[i];
+	const int numJoints = skeleton.size();
 
-		if (joint->parent && joint->parent->name == target && i != ignore_index)
-			return i;
-	}
+	// First and second child of every joint in index order - the sibling of a joint is the
+	// first other child of its parent
+	std::vector<int> firstChild(numJoints, -1);
+	std::vector<int> secondChild(numJoints, -1);
 
-	return -1;
-}
+	for (int i = 0; i < numJoints; i++)
+	{
+		int parent = skeleton.parents[i];
+		if (parent == -1)
+			continue;
 
-void
-CSkeletonSerializer::generateTransforms(std::shared_ptr<JSON> json, NSSkeleton& skeleton)
-{
-	const int numJoints = skeleton.joints.size();
-	int parent, child, sibling;
+		if (firstChild[parent] == -1)
+			firstChild[parent] = i;
+		else if (secondChild[parent] == -1)
+			secondChild[parent] = i;
+	}
 
 	for (int i = 0; i < numJoints; i++)
 	{
 		JSON tfmJson;
-		auto& joint = skeleton.joints[i];
+		auto& translate = skeleton.translates[i];
 
 		// Populate joint data
-		child   = ::findFirstChild(joint->name, skeleton.joints);
-		parent  = (joint->parent) ? joint->parent->index : -1;
-		sibling = (joint->parent) ? ::findFirstChild(joint->parent->name, skeleton.joints, i) : -1;
+		int parent  = skeleton.parents[i];
+		int child   = firstChild[i];
+		int sibling = (parent == -1) ? -1 : (firstChild[parent] != i) ? firstChild[parent] : secondChild[parent];
 
 		if (parent != -1)
 			tfmJson["Parent"] = parent;
@@ -65,8 +65,8 @@ CSkeletonSerializer::generateTransforms(std::shared_ptr<JSON> json, NSSkeleton&
 		if (sibling != -1)
 			tfmJson["Sibling"] = sibling;
 
-		tfmJson["Translate"]   = std::vector<float>{ joint->translate.x, joint->translate.y, joint->translate.z };
-		(*m_json)[joint->name] = tfmJson;
+		tfmJson["Translate"] = std::vector<float>{ translate.x, translate.y, translate.z };
+		(*m_json)[skeleton.getName(i)] = tfmJson;
 	}
 }
 
@@ -4,6 +4,8 @@
 #include <common.h>
 #include <bin_codec.h>
 #include <datastream.h>
+#include <unordered_map>
+#include <algorithm>
 
 CSkinJsonEncoder::CSkinJsonEncoder(std::shared_ptr<JSON>& parent,  Mesh& mesh,  NSSkeleton& skeleton)
 	:
@@ -18,7 +20,7 @@ void
 CSkinJsonEncoder::encode(const char* path, const char* subpath_title)
 {
 	// Validate mesh and skeleton
-	if (!m_mesh || !m_skeleton || m_mesh->skin.blendverts.empty())
+	if (!m_mesh || !m_skeleton || m_mesh->skin.empty())
 		return;
 		
 	// Write skin vertex streams
@@ -49,48 +51,29 @@ CSkinJsonEncoder::getVertexStreamIndex()
 	return size;
 }
 
-inline static bool hasMatchingSkin(const MatrixPalette& in, const MatrixPalette& other)
+inline static uint16_t packWeight(float value)
 {
-	if (in.groups.size() > other.groups.size())
-		return false;
-
-	for (int k = 0; k < in.groups.size(); k++)
-		if (in.groups[k] != other.groups[k])
-			return false;
-
-	return true;
-}
+	// Convert to 16-bit unsigned integer range (0 to 65535)
+	return static_cast<uint16_t>(value * 65535.0f);
+};
 
-inline static int findMatrixIndex(std::vector<MatrixPalette>& table, const MatrixPalette& target)
+// Raw bytes of a run of palette entries - used as hash key
+inline static std::string getPaletteKey(const uint32_t* entries, const size_t count)
 {
-	// Ignore single weighted vertices
-	if (target.groups.size() <= 1)
-		return -1;
-
-	// Scan table for target skin index/weight pairs
-	for (int i = 0; i < table.size(); i++)
-	{
-		// Check if matrix element fits our target skin group
-		if (::hasMatchingSkin(target, table[i]))
-			return i;
-	}
-	
-	// skin group not found - push and return last index
-	table.push_back(target);
-	return (table.size() - 1);
+	return std::string(reinterpret_cast<const char*>(entries), count * sizeof(uint32_t));
 }
 
-inline static MatrixPalette getVertexPalette(const BlendVertex& vertex)
+inline static void getVertexPalette(const Skin& skin, const size_t vtx, std::vector<uint32_t>& entries)
 {
-	MatrixPalette matrix;
-
-	int num_weights = vertex.indices.size();
-	matrix.groups.resize(num_weights);
+	uint32_t begin = skin.offsets[vtx];
+	int num_weights = skin.getNumInfluences(vtx);
+	entries.resize(num_weights);
 
+	// Entries are compared as written to the buffer, so palettes equal after quantization share one slot
 	for (int j = 0; j < num_weights; j++)
-		matrix.groups[j] = MatrixGroup{ vertex.indices[j], vertex.weights[j] };
+		entries[j] = (uint32_t(skin.joints[begin + j]) << 0x10) | ::packWeight(skin.weights[begin + j]);
 
-	return matrix;
+	std::sort(entries.begin(), entries.end());
 }
 
 inline static void packVertexCoordsAndWeights(Mesh& mesh, VertexStream& position, std::vector<float>& weights)
@@ -110,8 +93,7 @@ inline static void encodeVertexWeights(std::vector<float>& data,
 {
 	for (int i = 0; i < links.size(); i++)
 	{
-		auto& blend = mesh.skin.blendverts[i];
-		auto encoded = links[i].pack(table, blend);
+		auto encoded = links[i].pack(table, mesh.skin, i);
 		data.push_back(*reinterpret_cast<float*>(&encoded));
 	}
 }
@@ -136,32 +118,49 @@ CSkinJsonEncoder::writeWeightData()
 	(*m_json)["VertexStream"] = srm;
 }
 
-inline static uint16_t packWeight(float value)
+void
+CSkinJsonEncoder::packMatrices(std::vector<float>& data)
 {
-	// Convert to 16-bit unsigned integer range (0 to 65535)
-	return static_cast<uint16_t>(value * 65535.0f);
-};
+	data.resize(m_matrixData.size());
+
+	for (size_t i = 0; i < m_matrixData.size(); i++)
+		data[i] = *reinterpret_cast<const float*>(&m_matrixData[i]);
+}
 
 void
-CSkinJsonEncoder::packMatrices(std::vector<float>& data)
+CSkinJsonEncoder::layoutMatrices()
 {
-	int offset = 0;
+	// Longest palettes are written first, shorter ones reuse any run of the buffer they match
+	std::vector<int> order(m_matrixTable.size());
+	for (size_t i = 0; i < order.size(); i++)
+		order[i] = static_cast<int>(i);
+
+	std::stable_sort(order.begin(), order.end(), [this](int a, int b) {
+		return m_matrixTable[a].entries.size() > m_matrixTable[b].entries.size();
+	});
+
+	std::unordered_map<std::string, uint32_t> runs;
+	m_matrixData.clear();
 
-	for (int i = 0; i < m_matrixTable.size(); i++)
+	for (auto& index : order)
 	{
-		auto& matrixEle = m_matrixTable[i];
-		matrixEle.offset = offset;
+		auto& palette = m_matrixTable[index];
+		auto& entries = palette.entries;
 
-		for (int k = 0; k < matrixEle.groups.size(); k++)
+		auto it = runs.find(::getPaletteKey(entries.data(), entries.size()));
+		if (it != runs.end())
 		{
-			auto& pair = matrixEle.groups[k];
-
-			uint16_t weight  = ::packWeight(pair.weight);
-			uint32_t encoded = (pair.boneIndex << 0x10) | weight;
-			data.push_back(*reinterpret_cast<float*>(&encoded)); 
+			palette.offset = it->second;
+			continue;
 		}
 
-		offset += matrixEle.groups.size();
+		palette.offset = static_cast<uint32_t>(m_matrixData.size());
+		m_matrixData.insert(m_matrixData.end(), entries.begin(), entries.end());
+
+		// Register every contiguous run of two or more entries, first writer keeps the slot
+		for (size_t begin = 0; begin + 1 < entries.size(); begin++)
+			for (size_t count = 2; begin + count <= entries.size(); count++)
+				runs.emplace(::getPaletteKey(&entries[begin], count), palette.offset + uint32_t(begin));
 	}
 }
 
@@ -195,30 +194,46 @@ void
 CSkinJsonEncoder::createMatrixBuffer()
 {
 	// Resize vectors
-	int numVerts = m_mesh->skin.blendverts.size();
+	int numVerts = m_mesh->skin.getNumVerts();
 	m_vertexLinks.resize(numVerts);
+	m_matrixTable.clear();
+
+	std::unordered_map<std::string, int> paletteIndex;
+	std::vector<uint32_t> entries;
 
 	// Iterate skin vertices
 	for (int i = 0; i < numVerts; i++)
 	{
-		auto& blend = m_mesh->skin.blendverts[i];
-		auto& link  = m_vertexLinks[i];
+		auto& link = m_vertexLinks[i];
+		::getVertexPalette(m_mesh->skin, i, entries);
+
+		// Ignore single weighted vertices
+		if (entries.size() <= 1)
+		{
+			link.pair_index = -1;
+			continue;
+		}
+
+		auto result = paletteIndex.emplace(::getPaletteKey(entries.data(), entries.size()), int(m_matrixTable.size()));
+		if (result.second)
+			m_matrixTable.push_back(MatrixPalette{ entries, 0 });
 
-		MatrixPalette matrix = ::getVertexPalette(blend);
-		link.pair_index      = ::findMatrixIndex(m_matrixTable, matrix);
+		link.pair_index = result.first->second;
 	}
 
+	this->layoutMatrices();
 	this->writeMatrixData();
 }
 
 uint32_t
-VertexWeightLink::pack(const std::vector<MatrixPalette>& table, const BlendVertex& vertex) const
+VertexWeightLink::pack(const std::vector<MatrixPalette>& table, const Skin& skin, const size_t vtx) const
 {
-	int numWeights = std::max(int(vertex.indices.size() - 1), 0);
+	int numInfluences = skin.getNumInfluences(vtx);
+	int numWeights = std::max(numInfluences - 1, 0);
 
 	int index = (pair_index == -1)
 		?
-		/* Interpret index as bone index */ ((vertex.indices.empty()) ? 0 : vertex.indices.front())
+		/* Interpret index as bone index */ ((numInfluences == 0) ? 0 : skin.joints[skin.offsets[vtx]])
 		:
 		/* Interpret index as buffer index */ pair_index;
 
@@ -3,32 +3,16 @@
 
 
 // Skin Matrix Encoder structs
-struct MatrixGroup
-{
-	int boneIndex;
-	float weight;
-
-	bool operator==(const MatrixGroup& other) const 
-	{
-		return (this->boneIndex == other.boneIndex) && (this->weight == other.weight);
-	}
-
-	bool operator!=(const MatrixGroup& other) const
-	{
-		return (this->boneIndex != other.boneIndex) || (this->weight != other.weight);
-	}
-};
-
 struct MatrixPalette
 {
-	std::vector<MatrixGroup> groups;
+	std::vector<uint32_t> entries; // (boneIndex << 16) | 16-bit weight, sorted
 	uint32_t offset;
 };
 
 struct VertexWeightLink
 {
 	int pair_index = -1;
-	uint32_t pack(const std::vector<MatrixPalette>& table, const BlendVertex& vertex) const;
+	uint32_t pack(const std::vector<MatrixPalette>& table, const Skin& skin, const size_t vtx) const;
 };
 
 
@@ -44,6 +28,7 @@ public:
 
 private:
 	void createMatrixBuffer();
+	void layoutMatrices();
 	void writeWeightData();
 	void writeMatrixData();
 	void packMatrices(std::vector<float>& data);
@@ -51,6 +36,7 @@ private:
 
 private:
 	std::vector<MatrixPalette> m_matrixTable;
+	std::vector<uint32_t> m_matrixData;
 	std::vector<VertexWeightLink> m_vertexLinks;
 
 	// members
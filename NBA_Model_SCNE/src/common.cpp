@@ -11,8 +11,6 @@
 #define _HAS_STD_BYTE 0
 namespace fs = std::filesystem;
 
-std::string WORKING_DIR = "";
-
 char* common::readFile(const std::string& filename, size_t* data_length)
 {
 	std::ifstream file(filename, std::ios::binary | std::ios::ate);
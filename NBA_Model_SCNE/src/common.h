@@ -2,6 +2,7 @@
 
 #include <string>
 #include <vector>
+#include <memory_resource>
 
 #define TEXT_GREEN_CON 2
 #define TEXT_RED_CON 4
@@ -9,9 +10,6 @@
 #define TEXT_WHITE_CON 7
 #define TEXT_AQUA_CON 3
 
-// store active file path to global scope
-extern std::string WORKING_DIR;
-
 namespace common
 {
     char* readFile(const std::string& filename, size_t* data_length = nullptr);
@@ -6,13 +6,19 @@
 #include <gzip/utils.hpp>
 #include <bin_codec.h>
 #include <filesystem>
+#include <cstring>
 
-CDataBuffer::CDataBuffer()
+CDataBuffer::CDataBuffer(CLoadContext* context, std::pmr::memory_resource* arena)
 	:
 	CDataStream(),
+	translate(arena),
+	scale(arena),
 	m_index(0),  // Changed from NULL to 0 - default to stream 0
-	m_size(NULL)
+	m_size(NULL),
+	m_fused(false),
+	m_deferDecode(false)
 {
+	this->setContext(context);
 }
 
 int CDataBuffer::getStreamIdx()
@@ -30,16 +36,14 @@ void CDataBuffer::setOffset(int val)
 	m_offset = val;
 }
 
-std::string CDataBuffer::getEncoding()
+const std::string& CDataBuffer::getEncoding() const
 {
-	return common::splitString(m_format, '_').front();
+	return m_encoding;
 }
 
-std::string CDataBuffer::getType()
+const std::string& CDataBuffer::getType() const
 {
-	auto type = common::splitString(m_format, '_').back();
-	::common::str_to_lower(type);
-	return type;
+	return m_type;
 }
 
 std::string CDataBuffer::getFormat() {
@@ -51,13 +55,87 @@ int CDataBuffer::getStride()
 	if (m_stride > 0 || m_format.empty())
 		return m_stride;
 	// Manually calculate stride length if non available
-	auto encoding = getEncoding();
-	auto type = getType();
-	BinaryCodec codec(encoding, type);
+	BinaryCodec codec(getEncoding(), getType());
 	m_stride = codec.size(1);
 	return m_stride;
 }
 
+void CDataBuffer::setAttribTfm(const StAttribTfm& tfm)
+{
+	m_tfm = tfm;
+}
+
+const StAttribTfm& CDataBuffer::getAttribTfm() const
+{
+	return m_tfm;
+}
+
+bool CDataBuffer::hasFusedData() const
+{
+	return m_fused;
+}
+
+void CDataBuffer::setDeferDecode(bool val)
+{
+	m_deferDecode = val;
+}
+
+bool CDataBuffer::isPacked() const
+{
+	return !m_packed.empty();
+}
+
+void CDataBuffer::unpack()
+{
+	if (m_packed.empty())
+		return;
+
+	BinaryCodec codec(getEncoding(), getType());
+	int elemSize = codec.size(1);
+	size_t items = m_packed.size() / elemSize;
+
+	char* src = reinterpret_cast<char*>(m_packed.data());
+	codec.decode(src, items, data, 0, elemSize);
+
+	m_packed.clear();
+	m_packed.shrink_to_fit();
+}
+
+const IndexData& CDataBuffer::getIndexData() const
+{
+	return m_indices;
+}
+
+size_t CDataBuffer::getNumValues() const
+{
+	if (auto u16 = std::get_if<std::vector<uint16_t>>(&m_indices))
+		return u16->size();
+	if (auto u32 = std::get_if<std::vector<uint32_t>>(&m_indices))
+		return u32->size();
+	return data.size();
+}
+
+uint32_t CDataBuffer::getUInt(const size_t index) const
+{
+	if (auto u16 = std::get_if<std::vector<uint16_t>>(&m_indices))
+		return (*u16)[index];
+	if (auto u32 = std::get_if<std::vector<uint32_t>>(&m_indices))
+		return (*u32)[index];
+	return static_cast<uint32_t>(data[index]);
+}
+
+void CDataBuffer::copyUInts(const size_t begin, const size_t count, uint32_t* dst) const
+{
+	// Widen a range of integer values straight into the destination
+	if (auto u16 = std::get_if<std::vector<uint16_t>>(&m_indices))
+		std::copy(u16->begin() + begin, u16->begin() + begin + count, dst);
+	else if (auto u32 = std::get_if<std::vector<uint32_t>>(&m_indices))
+		memcpy(dst, u32->data() + begin, count * sizeof(uint32_t));
+	else
+		for (size_t i = 0; i < count; i++)
+			dst[i] = static_cast<uint32_t>(data[begin + i]);
+}
+
 int CDataBuffer::getDataOffset()
 {
 	return m_offset;
@@ -68,7 +146,7 @@ void CDataBuffer::parse(JSON& json)
 	for (JSON::iterator it = json.begin(); it != json.end(); ++it)
 	{
 		auto key = common::chash(it.key());
-		auto value = it.value();
+		auto& value = it.value();
 		switch (key)
 		{
 		case enPropertyTag::FORMAT:
@@ -99,10 +177,23 @@ void CDataBuffer::parse(JSON& json)
 			break;
 		};
 	}
+
+	// Split the format once - codec lookups query encoding/type per access
+	if (!m_format.empty())
+	{
+		// The type is the one of the encoded channels - "R10G10B10_SNORM_A2_UNORM" packs snorm xyz, the A2 tail is not part of the codec
+		auto tokens = common::splitString(m_format, '_');
+		m_encoding = (tokens.empty()) ? m_format : tokens.front();
+		m_type = (tokens.empty()) ? "" : common::to_lower(tokens.back().substr(0, tokens.back().find('_')));
+	}
 }
 
 void CDataBuffer::readFileData(char*& data, size_t& file_size)
 {
+	// Cancelled loads stop at the next buffer
+	if (m_context)
+		m_context->checkCancelled();
+
 	m_binaryPath = this->findBinaryFile();
 	data = common::readFile(m_binaryPath, &file_size);
 	/* Missing model data - must throw exception */
@@ -110,12 +201,50 @@ void CDataBuffer::readFileData(char*& data, size_t& file_size)
 		printf("\n[CDataBuffer] Invalid scene - inaccessible data file: %s\n", m_path.c_str());
 		throw std::runtime_error("Invalid data buffer.");
 	}
+
+	if (m_context)
+		m_context->addBytesRead(file_size);
+}
+
+template <typename T>
+static void readNativeData(const char* src, const size_t items, const uint64_t offset, const uint32_t stride, std::vector<T>& target)
+{
+	target.resize(items);
+
+	if (stride == sizeof(T)) {
+		memcpy(target.data(), src + offset, items * sizeof(T));
+		return;
+	}
+
+	for (size_t i = 0; i < items; i++)
+		memcpy(&target[i], src + offset + (i * stride), sizeof(T));
+}
+
+bool CDataBuffer::loadIndexData(char* src, const size_t& size, const size_t items)
+{
+	// Single channel unsigned streams are kept at their native width
+	if (getType() != "uint")
+		return false;
+
+	const std::string& encoding = getEncoding();
+	size_t elemSize = (encoding == "R16") ? sizeof(uint16_t) : (encoding == "R32") ? sizeof(uint32_t) : 0;
+	size_t end = (items) ? ((items - 1) * getStride()) + m_offset + elemSize : 0;
+	if (elemSize == 0 || end > size)
+		return false;
+
+	if (elemSize == sizeof(uint16_t))
+		::readNativeData(src, items, m_offset, getStride(), m_indices.emplace<std::vector<uint16_t>>());
+	else
+		::readNativeData(src, items, m_offset, getStride(), m_indices.emplace<std::vector<uint32_t>>());
+
+	printf("\n  - Native %s decode: %zu values", encoding.c_str(), items);
+	return true;
 }
 
 void CDataBuffer::loadFileData(char* src, const size_t& size)
 {
-	std::string encoding = getEncoding();
-	std::string type = getType();
+	const std::string& encoding = getEncoding();
+	const std::string& type = getType();
 
 	// Validate memory buffer size with target length
 	BinaryCodec codec(encoding, type);
@@ -130,6 +259,46 @@ void CDataBuffer::loadFileData(char* src, const size_t& size)
 	printf("\n  - Stride: %d, Offset: %d", getStride(), m_offset);
 	printf("\n  - Items: %zu, DataSize needed: %zu, Buffer size: %zu", items, dataSize, size);
 
+	// Fused decode - unpack, dequantize and axis convert in a single pass
+	if (m_tfm.kernel != enAttribKernel::NONE && BinKernel::supports(m_tfm, m_format))
+	{
+		size_t end = (items) ? ((items - 1) * getStride()) + m_offset + BinKernel::elementSize(m_format) : 0;
+
+		// Tangent frames keep their raw channels for re-encoding - normals are decoded alongside
+		if (m_tfm.kernel == enAttribKernel::TANGENTFRAME && end <= size)
+		{
+			BinKernel::decodeTangentFrames(src, items, m_offset, getStride(), m_format, frameNormals);
+			printf("\n  - Tangent frame decode: %zu normals", frameNormals.size() / 3);
+		}
+		else if (end <= size)
+		{
+			StAttribTfm tfm = m_tfm;
+			tfm.setScaleOffset(scale, translate);
+			m_fused = BinKernel::decode(src, items, m_offset, getStride(), m_format, tfm, data);
+		}
+
+		if (m_fused) {
+			printf("\n  - Fused decode: %zu floats", data.size());
+			return;
+		}
+	}
+
+	if (this->loadIndexData(src, size, items))
+		return;
+
+	// Keep attributes packed until a consumer requests them
+	size_t end = (items) ? ((items - 1) * getStride()) + m_offset + codec.size(1) : 0;
+	if (m_deferDecode && end <= size)
+	{
+		size_t elemSize = codec.size(1);
+		m_packed.resize(items * elemSize);
+		for (size_t i = 0; i < items; i++)
+			memcpy(&m_packed[i * elemSize], src + m_offset + (i * getStride()), elemSize);
+
+		printf("\n  - Deferred decode: %zu packed bytes", m_packed.size());
+		return;
+	}
+
 	// load data elements from binary
 	if (dataSize <= size) {
 		codec.decode(src, items, data, m_offset, m_stride);
@@ -1,12 +1,18 @@
 /* Stores and extrapolates abstract data from JSON and binary input */
 #include <datastream.h>
+#include <bin_kernel.h>
 #include <json.hpp>
+#include <variant>
+#include <memory_resource>
 #pragma once 
 
 using JSON = nlohmann::ordered_json;
 
 class CNBAModel;
 
+// Native width storage for integer streams (indices, packed skin words) - 'data' stays empty when used
+using IndexData = std::variant<std::monostate, std::vector<uint16_t>, std::vector<uint32_t>>;
+
 enum enPropertyTag {
 	FORMAT = 3007389838,
 	STREAM = 3522070833,
@@ -21,7 +27,7 @@ enum enPropertyTag {
 class CDataBuffer : public CDataStream
 {
 public:
-	CDataBuffer();
+	CDataBuffer(CLoadContext* context = nullptr, std::pmr::memory_resource* arena = std::pmr::get_default_resource());
 public:
 	void parse(JSON& json);
 	bool saveBinary(char* data, const size_t size);
@@ -32,21 +38,41 @@ public:
 	int getStreamIdx();
 	void setStride(int val);
 	void setOffset(int val);
+	void setAttribTfm(const StAttribTfm& tfm);
+	const StAttribTfm& getAttribTfm() const;
+	bool hasFusedData() const; // data already holds final kernel output
+	void setDeferDecode(bool val);
+	bool isPacked() const;
+	void unpack(); // decodes deferred attributes into 'data'
+public:
+	const IndexData& getIndexData() const;
+	size_t getNumValues() const;
+	uint32_t getUInt(const size_t index) const;
+	void copyUInts(const size_t begin, const size_t count, uint32_t* dst) const;
 public:
 	std::vector<uint8_t> getBinary(); // returns a copy of the source binary buffer
 	std::string getFormat();
-	std::string getEncoding();
-	std::string getType();
+	const std::string& getEncoding() const;
+	const std::string& getType() const;
 public:
 	std::string id;
-	std::vector<float> translate;
-	std::vector<float> scale;
+	std::pmr::vector<float> translate;
+	std::pmr::vector<float> scale;
+	std::vector<float> frameNormals; // unit normals from the tangent frame kernel
 private:
 	void loadFileData(char* src, const size_t& size);
+	bool loadIndexData(char* src, const size_t& size, const size_t items);
 	void readFileData(char*& data, size_t& file_size);
 	void updateSceneReference(const std::string& newPath);
 private:
 	int m_index;
 	std::string m_format;
+	std::string m_encoding; // split from m_format once in parse()
+	std::string m_type;
 	int m_size;
+	StAttribTfm m_tfm;
+	bool m_fused;
+	bool m_deferDecode;
+	IndexData m_indices;
+	std::vector<uint8_t> m_packed;
 };
\ No newline at end of file
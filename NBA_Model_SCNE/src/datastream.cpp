@@ -1,6 +1,7 @@
 #include <datastream.h>
 #include <bin_codec.h>
 #include <common.h>
+#include <loadcontext.h>
 #include <fstream>
 #include <filesystem>
 #include <gzip/utils.hpp>
@@ -9,6 +10,7 @@
 
 CDataStream::CDataStream()
 	:
+	m_context(nullptr),
 	m_offset(NULL),
 	m_stride(NULL)
 {
@@ -135,11 +137,15 @@ bool CDataStream::decompressGzFile(const std::string& filePath, std::string& tar
 
 std::string CDataStream::findBinaryFile()
 {
+	// Streams without a load context have nowhere to look
+	if (!m_context)
+		return "";
+
 	std::string targetName = std::filesystem::path(m_path).filename().string();
 	bool isCompressed = common::containsSubstring(m_path, ".gz");
 	if (isCompressed)
 	{
-		auto compressedPath = common::findFileInDirectory(WORKING_DIR, targetName);
+		auto compressedPath = m_context->findFile(targetName);
 		if (!compressedPath.empty())
 		{
 			std::string outPath = compressedPath;
@@ -151,5 +157,5 @@ std::string CDataStream::findBinaryFile()
 			common::replaceSubString(targetName, ".gz", ".bin");
 		}
 	}
-	return common::findFileInDirectory(WORKING_DIR, targetName);
+	return m_context->findFile(targetName);
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 #include <string>
 #include <vector>
 
+class CLoadContext;
+
 class CDataStream
 {
 public:
@@ -18,6 +20,9 @@ public:
 	void setPath(const std::string& path) {
 		m_path = path;
 	}
+	void setContext(CLoadContext* context) {
+		m_context = context; // binaries are looked up below the context's working directory
+	}
 
 protected:
 	bool decompressGzFile(const std::string& filePath, std::string& targetPath);
@@ -26,6 +31,7 @@ protected:
 protected:
 	std::string m_path;           // ✓ Keep only ONE declaration
 	std::string m_binaryPath;
+	CLoadContext* m_context; // progress is reported while binaries are read
 	int m_offset;
 	int m_stride;
 };
\ No newline at end of file
@@ -100,6 +100,7 @@ void setMeshData(void* pMesh, float* position, int* indexList, int numVerts, int
 
 	/* Update counts - use correct component count for alignment */
 	mesh->alignPosition(true, mesh->vertexComponents);
+	mesh->clearBlenderViews();
 	mesh->generateAABBs();
 
 	printf("\n[setMeshData] Final mesh has %d vertices (%d components each)",
@@ -129,6 +130,7 @@ void setMeshNormals(void* pMesh, float* normals, int size)
 		mesh->normals[i] = normals[i];
 
 	mesh->alignNormals(true, 3);  // Normals are always 3-component
+	mesh->clearBlenderViews();
 }
 
 void addUvMap(void* pMesh, float* texcoords, int size)
@@ -146,9 +148,8 @@ void addUvMap(void* pMesh, float* texcoords, int size)
 
 	mesh->uvs.push_back(channel);
 
-	// Pack tangent frames
-	MeshCalc::calculateTangentsBinormals(*mesh);
-	MeshCalc::buildTangentFrameVec(*mesh, mesh->tangent_frames);
+	// Tangent frames are packed on save, together with the model's other meshes
+	mesh->tangent_frames.clear();
 }
 
 void saveModelToFile(void* pModel, const char* savePath)
@@ -168,6 +169,26 @@ void saveModelToFile(void* pModel, const char* savePath)
 	serializer.save(savePath);
 }
 
+void setExportVertexOrder(bool optimize)
+{
+	OPTIMIZE_VERTEX_ORDER = optimize;
+}
+
+void setExportLodRatios(float* ratios, int count)
+{
+	LOD_RATIOS.assign(ratios, ratios + std::max(count, 0));
+}
+
+void setExportPositionError(float maxError)
+{
+	POSITION_MAX_ERROR = maxError;
+}
+
+void setExportInterleaved(bool interleave)
+{
+	INTERLEAVE_VERTEX_STREAMS = interleave;
+}
+
 void linkMeshToModel(void* pModel, void* pMesh)
 {
 	// Convert void pointer back to CNBAModel pointer
@@ -214,23 +235,10 @@ void setNewModelBone(
 	CNBAModel* model = static_cast<CNBAModel*>(pModel);
 	if (!model) return;
 
-	// Create a new bone
-	std::string parent_id(parent);
+	// Create a new bone - parents are exported before their children
 	auto& skeleton = model->getSkeleton();
-	auto bone = std::make_shared<NSJoint>(NSJoint{ index, name });
-	bone->translate = Vec3{ matrices[0], matrices[2], -matrices[1] };
-
-	if (!parent_id.empty())
-	{
-		auto joint = skeleton.findJoint(parent);
-		if (joint)
-		{
-			bone->parent = joint;
-			joint->children.push_back(bone);
-		}
-	}
-
-	skeleton.addJoint(bone);
+	int parent_index = (parent && parent[0]) ? skeleton.findJoint(parent) : -1;
+	skeleton.addJoint(name, parent_index, Vec3{ matrices[0], matrices[2], -matrices[1] });
 };
 
 inline static void normalize_data_16_bits(float* data, const int size)
@@ -249,14 +257,14 @@ void setMeshSkinData(void* pMesh, int* indices, float* weights, int size, int nu
 
 	int num_verts = size / num_weights;
 	int arr_index;
-	mesh->skin.blendverts.resize(num_verts);
+	auto& skin = mesh->skin;
+	skin.clear();
+	skin.reserve(num_verts, size);
 
 	::normalize_data_16_bits(weights, size);
 
 	for (int i = 0; i < num_verts; i++)
 	{
-		auto& vertex = mesh->skin.blendverts[i];
-
 		for (int j = 0; j < num_weights; j++)
 		{
 			arr_index = (i * num_weights) + j;
@@ -264,10 +272,8 @@ void setMeshSkinData(void* pMesh, int* indices, float* weights, int size, int nu
 			auto& weight = weights[arr_index];
 
 			if (weight > 0.0f)
-			{
-				vertex.indices.push_back(index);
-				vertex.weights.push_back(weight);
-			}
+				skin.pushInfluence(static_cast<uint16_t>(index), weight);
 		}
+		skin.endVertex();
 	};
 };
\ No newline at end of file
@@ -26,6 +26,10 @@ DLLEX void setNewModelBone(
 
 // Model Serializer Funcs
 DLLEX void saveModelToFile(void* pModel, const char* savePath);
+DLLEX void setExportVertexOrder(bool optimize);
+DLLEX void setExportLodRatios(float* ratios, int count);
+DLLEX void setExportPositionError(float maxError);
+DLLEX void setExportInterleaved(bool interleave);
 DLLEX void linkMeshToModel(void* pModel, void* pMesh);
 
 // Material Serializer Funcs
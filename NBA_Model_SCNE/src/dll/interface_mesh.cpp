@@ -1,11 +1,13 @@
 ﻿#include <dll/interface_mesh.h>
 #include <nbascene>
 #include <vector>
+#include <algorithm>
+#include <mutex>
+#include <morphs/morphset.h>
 
 void* loadModelFile(const char* filePath, void** filePtr)
 {
     /* Initialize CModelFile Address */
-    INCLUDE_LODS = false;
     *filePtr = nullptr;
 
     /* Load file and scene-contents */
@@ -29,6 +31,67 @@ void* loadModelFile(const char* filePath, void** filePtr)
     return nullptr;
 }
 
+void* beginLoadModelFile(const char* filePath, const bool includeLods, const bool debugLogs)
+{
+    if (!filePath)
+        return nullptr;
+
+    StLoadOptions options;
+    options.includeLods = includeLods;
+    options.debugLogs = debugLogs;
+
+    try {
+        return new CSceneLoad(filePath, options);
+    }
+    catch (...) {}
+
+    printf("[CNBAScene] Failed to start scene load.\n");
+    return nullptr;
+}
+
+int pollLoad(void* pLoad, StLoadProgress* progress)
+{
+    CSceneLoad* load = static_cast<CSceneLoad*>(pLoad);
+    if (!load)
+        return LOAD_FAILED;
+
+    auto state = load->poll();
+    if (progress)
+        *progress = state;
+
+    return state.stage;
+}
+
+void cancelLoad(void* pLoad)
+{
+    CSceneLoad* load = static_cast<CSceneLoad*>(pLoad);
+    if (!load) return;
+
+    load->cancel();
+}
+
+void* finishLoad(void* pLoad, void** filePtr)
+{
+    *filePtr = nullptr;
+
+    CSceneLoad* load = static_cast<CSceneLoad*>(pLoad);
+    if (!load)
+        return nullptr;
+
+    CSceneFile* file = load->finish();
+    delete load;
+
+    if (!file)
+    {
+        printf("[CNBAScene] Scene load failed or was cancelled.\n");
+        return nullptr;
+    }
+
+    *filePtr = file;
+    printf("\n[CNBAInterface] Found total models: %d\n", file->scene()->getNumModels());
+    return file->scene().get();
+}
+
 void release_model_file(void* filePtr)
 {
     CSceneFile* file = static_cast<CSceneFile*>(filePtr);
@@ -76,6 +139,9 @@ int getMeshTotal(void* pNbaModel)
     return model->getNumMeshes();
 }
 
+// Guards the lazily built per-mesh outputs - held while a getter checks or fills them, never while Python reads
+static std::mutex g_meshOutputMutex;
+
 const float* getVertexData(void* pNbaModel, const int index)
 {
     CNBAModel* model = static_cast<CNBAModel*>(pNbaModel);
@@ -87,31 +153,9 @@ const float* getVertexData(void* pNbaModel, const int index)
     if (!mesh)
         return nullptr;
 
-    // Different alignment for different vertex formats
-    if (mesh->vertexComponents == 3) {
-        // Characters: apply standard NBA to Blender transformation
-        mesh->alignPosition(true, 3);
-    }
-    else if (mesh->vertexComponents == 4) {
-        // Ball: skip alignment or use different transformation
-        // The scale/offset transform already positions it correctly
-        // Don't call alignPosition for 4-component meshes
-    }
-
-    // If 4-component mesh, strip W for Blender
-    if (mesh->vertexComponents == 4) {
-        static std::vector<float> vertices3D;
-        vertices3D.clear();
-
-        for (int i = 0; i < mesh->vertices.size(); i += 4) {
-            vertices3D.push_back(mesh->vertices[i]);
-            vertices3D.push_back(mesh->vertices[i + 1]);
-            vertices3D.push_back(mesh->vertices[i + 2]);
-        }
-        return vertices3D.data();
-    }
-
-    return mesh->vertices.data();
+    // Source positions stay untouched - the Blender view is built once and reused by every later call
+    std::lock_guard<std::mutex> lock(g_meshOutputMutex);
+    return mesh->getBlenderPositions();
 }
 
 int getNumVerts(void* pModel, const int index)
@@ -214,19 +258,26 @@ int getNumTriangles(void* pNbaModel, const int index)
     if (!mesh)
         return 0;
 
-    // Count valid triangles only
-    int numVerts = mesh->vertices.size() / mesh->vertexComponents;
-    int validTriangles = 0;
+    // Invalid triangles are stripped on load
+    return mesh->triangles.size();
+}
 
-    for (const auto& tri : mesh->triangles)
-    {
-        if (tri[0] < numVerts && tri[1] < numVerts && tri[2] < numVerts)
-        {
-            validTriangles++;
-        }
-    }
+uint64_t getMeshFingerprint(void* pNbaModel, const int index)
+{
+    CNBAModel* model = static_cast<CNBAModel*>(pNbaModel);
+    if (!model || index >= model->getNumMeshes())
+        return 0;
 
-    return validTriangles;
+    auto mesh = model->getMesh(index);
+    if (!mesh)
+        return 0;
+
+    // Scene loads index every mesh - other load paths compute it on first request
+    std::lock_guard<std::mutex> lock(g_meshOutputMutex);
+    if (mesh->fingerprint.empty())
+        mesh->fingerprint = GeomDef::computeFingerprint(*mesh);
+
+    return mesh->fingerprint.key();
 }
 
 const uint32_t* getMeshTriangleList(void* pNbaModel, const int index) {
@@ -240,37 +291,9 @@ const uint32_t* getMeshTriangleList(void* pNbaModel, const int index) {
     if (!mesh)
         return nullptr;
 
-    // Get actual vertex count
-    int numVerts = mesh->vertices.size() / mesh->vertexComponents;
-
-    // Sanitize triangle indices
-    static std::vector<uint32_t> sanitized;
-    sanitized.clear();
-    sanitized.reserve(mesh->triangles.size() * 3);
-
-    int skipped = 0;
-    for (const auto& tri : mesh->triangles)
-    {
-        // Check if all three vertices are valid
-        if (tri[0] < numVerts && tri[1] < numVerts && tri[2] < numVerts)
-        {
-            sanitized.push_back(tri[0]);
-            sanitized.push_back(tri[1]);
-            sanitized.push_back(tri[2]);
-        }
-        else
-        {
-            skipped++;
-        }
-    }
-
-    if (skipped > 0)
-    {
-        printf("\n[Interface] WARNING: Skipped %d triangles with invalid vertex indices (max vertex: %d)",
-            skipped, numVerts - 1);
-    }
-
-    return sanitized.data();
+    // Triangles are a contiguous uint32 array - hand it over without copying
+    static_assert(sizeof(Triangle) == sizeof(uint32_t) * 3, "Triangle must be tightly packed");
+    return (mesh->triangles.empty()) ? nullptr : mesh->triangles.front().data();
 }
 
 const float* getMeshNormals(void* pNbaModel, const int index) {
@@ -282,16 +305,8 @@ const float* getMeshNormals(void* pNbaModel, const int index) {
     if (!mesh || mesh->normals.empty())
         return nullptr;
 
-    // ✓ Only align 3-component meshes, skip 4-component entirely
-    if (mesh->vertexComponents == 3) {
-        mesh->alignNormals(true, 3);  // NBA→Blender
-        printf("\n[getMeshNormals] Aligned normals for 3-component mesh");
-    }
-    else {
-        printf("\n[getMeshNormals] Skipped alignment for 4-component mesh");
-    }
-
-    return mesh->normals.data();
+    std::lock_guard<std::mutex> lock(g_meshOutputMutex);
+    return mesh->getBlenderNormals();
 }
 
 void freeMemory_intArr(int* data)
@@ -322,20 +337,7 @@ int getNumBones(void* pNbaModel)
     CNBAModel* model = static_cast<CNBAModel*>(pNbaModel);
     if (!model) return 0;
 
-    auto skel = model->getSkeleton();
-    return skel.joints.size();
-}
-
-inline static int findParent(const std::vector<std::shared_ptr<NSJoint>>& joints, const std::string& id)
-{
-    for (auto& joint : joints)
-    {
-        for (auto& child : joint->children)
-            if (child->name == id)
-                return joint->index;
-    }
-
-    return -1;
+    return model->getSkeleton().size();
 }
 
 int getBoneParentIndex(void* pNbaModel, int joint_index)
@@ -344,12 +346,10 @@ int getBoneParentIndex(void* pNbaModel, int joint_index)
     if (!model) return -1;
 
     auto& skel = model->getSkeleton();
-    if (joint_index >= skel.joints.size())
+    if (!skel.isValid(joint_index))
         return -1;
 
-    auto& joint = skel.joints[joint_index];
-
-    return (joint->parent) ? joint->parent->index : -1;
+    return skel.parents[joint_index];
 }
 
 float* getBoneMatrix(void* pNbaModel, int joint_index)
@@ -359,15 +359,15 @@ float* getBoneMatrix(void* pNbaModel, int joint_index)
         return nullptr;
 
     auto& skel = model->getSkeleton();
-    if (joint_index >= skel.joints.size())
+    if (!skel.isValid(joint_index))
         return nullptr;
 
-    auto& joint = skel.joints[joint_index];
-    float* matrix = new float[16];
+    auto& translate = skel.translates[joint_index];
+    float* matrix = new float[16]();
 
-    matrix[0] = joint->translate.x;
-    matrix[1] = joint->translate.y;
-    matrix[2] = joint->translate.z;
+    matrix[0] = translate.x;
+    matrix[1] = translate.y;
+    matrix[2] = translate.z;
     return matrix;
 }
 
@@ -378,11 +378,10 @@ const char* getBoneName(void* pNbaModel, int joint_index)
         return "";
 
     auto& skel = model->getSkeleton();
-    if (joint_index >= skel.joints.size())
+    if (!skel.isValid(joint_index))
         return "";
 
-    auto& joint = skel.joints[joint_index];
-    return joint->name.c_str();
+    return skel.getName(joint_index).c_str();
 }
 
 void* getSkinData(void* pNbaModel, int mesh_index)
@@ -401,13 +400,23 @@ void* getSkinData(void* pNbaModel, int mesh_index)
     return &mesh->skin;
 }
 
-inline bool hasGroup(const std::vector<std::string*>& vec, const std::string* target)
+// Blend index -> vertex group index, groups are the named joints in first-use order (-1: unnamed)
+static int getSkinGroups(const Skin& skin, std::vector<int>& groupOf, std::vector<const std::string*>* names = nullptr)
 {
-    for (auto& string : vec)
-        if (*string == *target)
-            return true;
+    int numGroups = 0;
+    groupOf.assign(skin.jointNames.size(), -1);
 
-    return false;
+    for (auto& joint : skin.joints)
+    {
+        if (joint >= groupOf.size() || groupOf[joint] >= 0)
+            continue;
+
+        groupOf[joint] = numGroups++;
+        if (names)
+            names->push_back(&skin.jointNames[joint]);
+    }
+
+    return numGroups;
 }
 
 const char** getAllSkinGroups(void* pSkin, int* num_groups)
@@ -416,14 +425,10 @@ const char** getAllSkinGroups(void* pSkin, int* num_groups)
     if (!pSkin)
         return nullptr;
 
-    // Get all bones from skin
-    std::vector<std::string*> groups;
-    for (auto& vertex : skin->blendverts)
-    {
-        for (auto& bone : vertex.bones)
-            if (!hasGroup(groups, &bone))
-                groups.push_back(&bone);
-    }
+    // Collect named joints referenced by the skin, in first-use order
+    std::vector<int> groupOf;
+    std::vector<const std::string*> groups;
+    ::getSkinGroups(*skin, groupOf, &groups);
 
     // Convert std::vector<std::string> to array of char pointers
     *num_groups = static_cast<int>(groups.size());
@@ -436,34 +441,206 @@ const char** getAllSkinGroups(void* pSkin, int* num_groups)
     return arr;
 }
 
+void getSkinSize(void* pSkin, int* numVerts, int* numInfluences, int* numGroups)
+{
+    Skin* skin = static_cast<Skin*>(pSkin);
+    *numVerts = *numInfluences = *numGroups = 0;
+    if (!skin)
+        return;
+
+    std::vector<int> groupOf;
+    *numGroups = ::getSkinGroups(*skin, groupOf);
+    *numVerts = static_cast<int>(skin->getNumVerts());
+
+    for (auto& joint : skin->joints)
+        *numInfluences += (joint < groupOf.size()) ? 1 : 0;
+}
+
+bool getSkinInfluences(void* pSkin, uint32_t* offsets, uint16_t* groups, float* weights)
+{
+    Skin* skin = static_cast<Skin*>(pSkin);
+    if (!skin || !offsets || !groups || !weights)
+        return false;
+
+    std::vector<int> groupOf;
+    ::getSkinGroups(*skin, groupOf);
+
+    // Same CSR layout as Skin, minus influences of unnamed joints
+    size_t numVerts = skin->getNumVerts();
+    uint32_t count = 0;
+    offsets[0] = 0;
+
+    for (size_t i = 0; i < numVerts; i++)
+    {
+        for (uint32_t k = skin->offsets[i]; k < skin->offsets[i + 1]; k++)
+        {
+            auto joint = skin->joints[k];
+            if (joint >= groupOf.size())
+                continue;
+
+            groups[count] = static_cast<uint16_t>(groupOf[joint]);
+            weights[count] = skin->weights[k];
+            count++;
+        }
+        offsets[i + 1] = count;
+    }
+
+    return true;
+}
+
+bool getSkinWeightMatrix(void* pSkin, float* matrix)
+{
+    Skin* skin = static_cast<Skin*>(pSkin);
+    if (!skin || !matrix)
+        return false;
+
+    std::vector<int> groupOf;
+    size_t numGroups = ::getSkinGroups(*skin, groupOf);
+    size_t numVerts = skin->getNumVerts();
+    std::fill(matrix, matrix + numGroups * numVerts, 0.0f);
+
+    // One row per group - first influence wins, like getAllJointWeights
+    for (size_t i = 0; i < numVerts; i++)
+        for (uint32_t k = skin->offsets[i + 1]; k-- > skin->offsets[i];)
+        {
+            auto joint = skin->joints[k];
+            if (joint < groupOf.size())
+                matrix[groupOf[joint] * numVerts + i] = skin->weights[k];
+        }
+
+    return true;
+}
+
 float* getAllJointWeights(void* pSkin, const char* joint_name, int* size)
 {
     Skin* skin = static_cast<Skin*>(pSkin);
     if (!pSkin)
         return nullptr;
 
-    int numVerts = skin->blendverts.size();
+    int numVerts = skin->getNumVerts();
     float* vtxWeights = new float[numVerts];
 
-    // Iterate through skin data and get a weight list for all verts of specified bone..
+    // Resolve the joint name to its blend index once
+    std::vector<bool> isTarget(skin->jointNames.size(), false);
+    for (size_t i = 0; i < skin->jointNames.size(); i++)
+        isTarget[i] = (skin->jointNames[i] == joint_name);
+
+    // Scan each vertex influence range for the target joint
     for (int i = 0; i < numVerts; i++)
     {
-        auto& skinVtx = skin->blendverts.at(i);
-        int numBones = skinVtx.bones.size();
         vtxWeights[i] = 0.0f;
 
-        for (int j = 0; j < numBones; j++)
-            if (skinVtx.bones.at(j) == joint_name)
+        for (uint32_t k = skin->offsets[i]; k < skin->offsets[i + 1]; k++)
+        {
+            auto joint = skin->joints[k];
+            if (joint < isTarget.size() && isTarget[joint])
             {
-                vtxWeights[i] = skinVtx.weights.at(j);
+                vtxWeights[i] = skin->weights[k];
                 break;
             }
+        }
     }
 
     *size = numVerts;
     return vtxWeights;
 }
 
+inline static Mesh* getMorphMesh(void* pNbaModel, const int meshIndex)
+{
+    CNBAModel* model = static_cast<CNBAModel*>(pNbaModel);
+    if (!model || meshIndex >= model->getNumMeshes())
+        return nullptr;
+
+    auto mesh = model->getMesh(meshIndex);
+    return (mesh && mesh->morphs) ? mesh : nullptr;
+}
+
+inline static bool isMorphTarget(const Mesh* mesh, const int target)
+{
+    return mesh && target >= 0 && target < int(mesh->morphs->size());
+}
+
+int getNumMorphs(void* pNbaModel, const int meshIndex)
+{
+    auto mesh = ::getMorphMesh(pNbaModel, meshIndex);
+    return (mesh) ? int(mesh->morphs->size()) : 0;
+}
+
+const char* getMorphName(void* pNbaModel, const int meshIndex, const int target)
+{
+    auto mesh = ::getMorphMesh(pNbaModel, meshIndex);
+    if (!::isMorphTarget(mesh, target))
+        return "";
+
+    return mesh->morphs->getName(target).c_str();
+}
+
+int getMorphSize(void* pNbaModel, const int meshIndex, const int target)
+{
+    auto mesh = ::getMorphMesh(pNbaModel, meshIndex);
+    if (!::isMorphTarget(mesh, target))
+        return 0;
+
+    // Group views only count the rows of their own vertices
+    auto& morph = mesh->morphs->getTarget(target);
+    if (mesh->sourceVertices.empty())
+        return int(morph.indices.size());
+
+    auto viewMap = mesh->morphs->getViewMap(mesh->sourceVertices);
+    return int(std::count_if(morph.indices.begin(), morph.indices.end(),
+        [&](uint32_t vtx) { return viewMap[vtx] != CMorphSet::NO_VERTEX; }));
+}
+
+bool getMorphDeltas(void* pNbaModel, const int meshIndex, const int target, uint32_t* indices, float* deltas)
+{
+    auto mesh = ::getMorphMesh(pNbaModel, meshIndex);
+    if (!::isMorphTarget(mesh, target) || !indices || !deltas)
+        return false;
+
+    // Same space and vertex ids as getVertexData - group views renumber their rows, see getMorphSize
+    auto& morph = mesh->morphs->getTarget(target);
+    auto viewMap = mesh->morphs->getViewMap(mesh->sourceVertices);
+    bool toBlender = (mesh->vertexComponents == 3);
+    size_t row = 0;
+
+    for (size_t i = 0; i < morph.indices.size(); i++)
+    {
+        uint32_t vtx = (viewMap.empty()) ? morph.indices[i] : viewMap[morph.indices[i]];
+        if (vtx == CMorphSet::NO_VERTEX)
+            continue;
+
+        float d[3];
+        morph.getDelta(i, d);
+        indices[row] = vtx;
+        deltas[row * 3 + 0] = d[0];
+        deltas[row * 3 + 1] = (toBlender) ? -d[2] : d[1];
+        deltas[row * 3 + 2] = (toBlender) ? d[1] : d[2];
+        row++;
+    }
+
+    return true;
+}
+
+bool evaluateMorphs(void* pNbaModel, const int meshIndex, const float* weights, const int numWeights, float* vertices)
+{
+    auto mesh = ::getMorphMesh(pNbaModel, meshIndex);
+    if (!mesh || !weights || !vertices || numWeights < 0)
+        return false;
+
+    // Rows must still line up with the vertex buffer - the base is the same Blender view getVertexData returns
+    std::lock_guard<std::mutex> lock(g_meshOutputMutex);
+    size_t numVerts = mesh->vertices.size() / mesh->vertexComponents;
+    size_t numSource = (mesh->sourceVertices.empty()) ? numVerts : mesh->sourceVertices.size();
+    if (numSource != numVerts || (mesh->sourceVertices.empty() && numVerts != mesh->morphs->getNumVerts()))
+        return false;
+
+    const float* base = mesh->getBlenderPositions();
+    bool toBlender = (mesh->vertexComponents == 3);
+    auto viewMap = mesh->morphs->getViewMap(mesh->sourceVertices);
+    mesh->morphs->evaluate(base, 3, weights, size_t(numWeights), vertices, toBlender, viewMap);
+    return true;
+}
+
 const char** getAllFaceGroups(void* pNbaModel, const int meshIndex, int* size)
 {
     // Convert void pointer back to CSkinModel pointer
@@ -16,6 +16,12 @@ DLLEX void freeMemory_skinData(void* pSkinData);
 
 /* Interface methods for accessing 'CSkinModel' object data */
 DLLEX void* loadModelFile(const char* path, void** file);
+
+/* Background loading - poll until the stage is LOAD_DONE / LOAD_FAILED / LOAD_CANCELLED, then always call finishLoad */
+DLLEX void* beginLoadModelFile(const char* path, const bool includeLods, const bool debugLogs);
+DLLEX int   pollLoad(void* pLoad, StLoadProgress* progress); // returns the current enLoadStage
+DLLEX void  cancelLoad(void* pLoad); // stops at the next data buffer
+DLLEX void* finishLoad(void* pLoad, void** file); // waits, frees the handle and returns the scene like loadModelFile
 DLLEX void* getSceneModel(void* pNbaScene, const int index);
 DLLEX int             getModelTotal(void* pNbaScene);
 DLLEX int             getMeshTotal(void* pNbaModel);
@@ -27,6 +33,7 @@ DLLEX int             getVertexComponents(void* pNbaScene, const int index);
 DLLEX int             getNumUvChannels(void* pNbaScene, const int index);
 DLLEX const uint32_t* getMeshTriangleList(void* pNbaScene, const int index);
 DLLEX int             getNumTriangles(void* pNbaScene, const int index);
+DLLEX uint64_t        getMeshFingerprint(void* pNbaScene, const int index);
 DLLEX const float* getMeshUvChannel(void* pNbaScene, const int meshIndex, const int channelIndex);
 
 /* Interface methods for model transform and bounding data */
@@ -45,6 +52,18 @@ DLLEX void* getSkinData(void* pNbaModel, int mesh_index);
 DLLEX const char** getAllSkinGroups(void* pSkin, int* num_groups);
 DLLEX float* getAllJointWeights(void* pSkin, const char* joint_name, int* size);
 
+/* Bulk skin access - groups follow getAllSkinGroups order, buffers are allocated by the caller */
+DLLEX void getSkinSize(void* pSkin, int* numVerts, int* numInfluences, int* numGroups);
+DLLEX bool getSkinInfluences(void* pSkin, uint32_t* offsets, uint16_t* groups, float* weights); // offsets: numVerts + 1
+DLLEX bool getSkinWeightMatrix(void* pSkin, float* matrix); // numGroups x numVerts, one row per group
+
+/* Sparse morph targets - deltas are decoded on first access and returned in the mesh's current space */
+DLLEX int         getNumMorphs(void* pNbaModel, const int meshIndex);
+DLLEX const char* getMorphName(void* pNbaModel, const int meshIndex, const int target);
+DLLEX int         getMorphSize(void* pNbaModel, const int meshIndex, const int target); // touched vertices
+DLLEX bool        getMorphDeltas(void* pNbaModel, const int meshIndex, const int target, uint32_t* indices, float* deltas); // deltas: size x 3
+DLLEX bool        evaluateMorphs(void* pNbaModel, const int meshIndex, const float* weights, const int numWeights, float* vertices); // numVerts x 3
+
 /* Interface methods for retrieving 'CSkinModel' material groups */
 DLLEX const char** getAllFaceGroups(void* pSkinModel, const int meshIndex, int* size);
 DLLEX void         getMaterialFaceGroup(void* pSkinModel, const int meshIndex, const int groupIndex, int* faceBegin, int* faceSize);
\ No newline at end of file
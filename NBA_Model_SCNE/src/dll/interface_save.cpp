@@ -1,13 +1,12 @@
 #include <sceneupdate.h>
+#include <sceneindex.h>
+#include <common.h>
 #include <nbascene>
 #include <vector>
 #include <dll/interface_save.h>
 
 bool getFileStatus(const char* path)
 {
-    USE_DEBUG_LOGS = false;
-    INCLUDE_LODS   = false;
-
     /* Try to load file and contents */
     try
     {
@@ -29,16 +28,15 @@ bool getFileStatus(const char* path)
 bool updateMeshData(
     const char* path,
     const char* id,
+    const uint64_t fingerprint,
     float* position,
     float* texcoords,
     float* normals,
     const int numVerts,
     const int numFaces,
-    const int search_method)
+    const int search_method,
+    const int split_normals)
 {
-    USE_DEBUG_LOGS = false;
-    INCLUDE_LODS   = false;
-
     /* Try to load file and contents */
     try
     {
@@ -48,7 +46,22 @@ bool updateMeshData(
         if (file.scene()->empty())
             return false;
 
-        StUpdatePkg clientPkg{ id, position, texcoords, normals, numVerts, numFaces, search_method };
+        StUpdatePkg clientPkg{ id, fingerprint, position, texcoords, normals, numVerts, numFaces, search_method, split_normals };
+        bool hasTarget = (file.findTarget(clientPkg) != nullptr);
+
+        // Nothing in this file matches - mesh was linked from another scene in the same folder
+        auto ref = (hasTarget) ? std::nullopt :
+            CSceneIndex::instance().find(common::get_parent_directory(path), fingerprint, clientPkg.id);
+
+        if (ref && ref->path != path)
+        {
+            printf("\n[CNBAInterface] '%s' found in %s", id, ref->path.c_str());
+            CSceneUpdate owner(ref->path.c_str(), true);
+            owner.load();
+            owner.update(&clientPkg);
+            return true;
+        }
+
         file.update(&clientPkg);
         return true;
     }
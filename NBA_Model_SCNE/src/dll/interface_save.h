@@ -9,10 +9,12 @@ DLLEX bool getFileStatus(const char* path);
 DLLEX bool updateMeshData(
     const char* path,
     const char* id, 
+    const uint64_t fingerprint,
     float* position,
     float* texcoords,
     float* normals, 
     const int numVerts,
     const int numFaces,
-    const int search_method);
+    const int search_method,
+    const int split_normals);
 
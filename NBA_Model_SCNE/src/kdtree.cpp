@@ -0,0 +1,72 @@
+#include <kdtree.h>
+#include <algorithm>
+
+CKdTree::CKdTree(const float* points, const size_t numPoints, const int stride)
+{
+	if (numPoints == 0)
+		return;
+
+	std::vector<uint32_t> order(numPoints);
+	for (size_t i = 0; i < numPoints; i++)
+		order[i] = static_cast<uint32_t>(i);
+
+	m_nodes.reserve(2 * (numPoints / KD_LEAF_SIZE + 1));
+	this->build(order, points, stride, 0, static_cast<uint32_t>(numPoints));
+
+	// Leaves own contiguous runs of the final order
+	m_x.resize(numPoints);
+	m_y.resize(numPoints);
+	m_z.resize(numPoints);
+	m_ids.swap(order);
+
+	for (size_t i = 0; i < numPoints; i++)
+	{
+		const float* p = &points[size_t(m_ids[i]) * stride];
+		m_x[i] = p[0];
+		m_y[i] = p[1];
+		m_z[i] = p[2];
+	}
+}
+
+int32_t CKdTree::build(std::vector<uint32_t>& order, const float* points, const int stride, const uint32_t begin, const uint32_t end)
+{
+	int32_t index = static_cast<int32_t>(m_nodes.size());
+	m_nodes.push_back({ begin, end });
+
+	if (end - begin <= KD_LEAF_SIZE)
+		return index;
+
+	// Split the widest axis at the median
+	float lo[3] = { points[size_t(order[begin]) * stride + 0], points[size_t(order[begin]) * stride + 1], points[size_t(order[begin]) * stride + 2] };
+	float hi[3] = { lo[0], lo[1], lo[2] };
+
+	for (uint32_t i = begin + 1; i < end; i++)
+	{
+		const float* p = &points[size_t(order[i]) * stride];
+		for (int k = 0; k < 3; k++) {
+			lo[k] = std::min(lo[k], p[k]);
+			hi[k] = std::max(hi[k], p[k]);
+		}
+	}
+
+	int axis = 0;
+	for (int k = 1; k < 3; k++)
+		axis = (hi[k] - lo[k] > hi[axis] - lo[axis]) ? k : axis;
+
+	uint32_t mid = begin + (end - begin) / 2;
+	std::nth_element(order.begin() + begin, order.begin() + mid, order.begin() + end,
+		[points, stride, axis](uint32_t a, uint32_t b) {
+			return points[size_t(a) * stride + axis] < points[size_t(b) * stride + axis];
+		});
+
+	float split = points[size_t(order[mid]) * stride + axis];
+	int32_t left = this->build(order, points, stride, begin, mid);
+	int32_t right = this->build(order, points, stride, mid, end);
+
+	auto& node = m_nodes[index];
+	node.left = left;
+	node.right = right;
+	node.axis = axis;
+	node.split = split;
+	return index;
+}
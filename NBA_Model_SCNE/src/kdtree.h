@@ -0,0 +1,91 @@
+/* Static 3D k-d tree for radius queries - median split build, leaves stored as flat x/y/z runs so the distance loop vectorizes */
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#pragma once
+
+#define KD_LEAF_SIZE 16 // max points per leaf
+
+class CKdTree
+{
+public:
+	CKdTree(const float* points, const size_t numPoints, const int stride = 3);
+
+public:
+	size_t size() const { return m_ids.size(); }
+
+	// Calls fn(id, distanceSquared) for every point within 'radius' of (x, y, z)
+	template <typename Fn>
+	void forEachInRadius(const float x, const float y, const float z, const float radius, Fn&& fn) const;
+
+private:
+	struct StNode
+	{
+		uint32_t begin;
+		uint32_t end;
+		int32_t  left  = -1; // -1 for leaves
+		int32_t  right = -1;
+		int      axis  = 0;
+		float    split = 0.0f;
+	};
+
+	int32_t build(std::vector<uint32_t>& order, const float* points, const int stride, const uint32_t begin, const uint32_t end);
+
+private:
+	std::vector<StNode> m_nodes;
+	std::vector<float> m_x;
+	std::vector<float> m_y;
+	std::vector<float> m_z;
+	std::vector<uint32_t> m_ids;
+};
+
+template <typename Fn>
+void CKdTree::forEachInRadius(const float x, const float y, const float z, const float radius, Fn&& fn) const
+{
+	if (m_nodes.empty())
+		return;
+
+	const float query[3] = { x, y, z };
+	const float radiusSq = radius * radius;
+	float distSq[KD_LEAF_SIZE];
+
+	int32_t stack[64];
+	int top = 0;
+	stack[top++] = 0;
+
+	while (top > 0)
+	{
+		const StNode& node = m_nodes[stack[--top]];
+
+		if (node.left < 0)
+		{
+			const uint32_t count = node.end - node.begin;
+			const float* px = &m_x[node.begin];
+			const float* py = &m_y[node.begin];
+			const float* pz = &m_z[node.begin];
+
+			// Branch free so the compiler can vectorize it
+			for (uint32_t i = 0; i < count; i++)
+			{
+				float dx = px[i] - x;
+				float dy = py[i] - y;
+				float dz = pz[i] - z;
+				distSq[i] = dx * dx + dy * dy + dz * dz;
+			}
+
+			for (uint32_t i = 0; i < count; i++)
+				if (distSq[i] <= radiusSq)
+					fn(m_ids[node.begin + i], distSq[i]);
+			continue;
+		}
+
+		float delta = query[node.axis] - node.split;
+		int32_t nearChild = (delta <= 0.0f) ? node.left : node.right;
+		int32_t farChild = (delta <= 0.0f) ? node.right : node.left;
+
+		if (delta * delta <= radiusSq)
+			stack[top++] = farChild;
+		stack[top++] = nearChild;
+	}
+}
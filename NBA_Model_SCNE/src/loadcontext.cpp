@@ -0,0 +1,86 @@
+#include <loadcontext.h>
+#include <threadpool.h>
+#include <common.h>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+CLoadContext::CLoadContext(const std::string& workingDir, const StLoadOptions& options)
+	:
+	m_workingDir(workingDir),
+	m_options(options),
+	m_arena(LOAD_ARENA_BLOCK),
+	m_pool(&CThreadPool::instance()),
+	m_indexed(false),
+	m_stage(LOAD_QUEUED),
+	m_modelsLoaded(0),
+	m_modelsTotal(0),
+	m_meshesLoaded(0),
+	m_bytesRead(0),
+	m_cancelled(false)
+{
+}
+
+void CLoadContext::indexFiles() const
+{
+	m_indexed = true;
+
+	std::error_code error;
+	if (!fs::is_directory(m_workingDir, error))
+		return;
+
+	// Same walk order as common::findFileInDirectory - the first match of a name wins
+	for (auto it = fs::recursive_directory_iterator(m_workingDir, error); !error && it != fs::recursive_directory_iterator(); it.increment(error))
+		if (it->is_regular_file(error))
+			m_files.emplace(common::to_lower(it->path().filename().string()), it->path().string());
+}
+
+std::string CLoadContext::findFile(const std::string& filename) const
+{
+	std::lock_guard<std::mutex> lock(m_fileMutex);
+
+	if (!m_indexed)
+		this->indexFiles();
+
+	auto it = m_files.find(common::to_lower(filename));
+	if (it != m_files.end())
+		return it->second;
+
+	// Files written after the walk (e.g. decompressed binaries)
+	auto path = common::findFileInDirectory(m_workingDir, filename);
+	if (!path.empty())
+		m_files.emplace(common::to_lower(filename), path);
+
+	return path;
+}
+
+void CLoadContext::scanFiles() const
+{
+	std::lock_guard<std::mutex> lock(m_fileMutex);
+
+	if (!m_indexed)
+		this->indexFiles();
+}
+
+void CLoadContext::addModel(const int numMeshes)
+{
+	m_meshesLoaded += numMeshes;
+	m_modelsLoaded++;
+}
+
+StLoadProgress CLoadContext::getProgress() const
+{
+	StLoadProgress progress;
+	progress.stage = m_stage;
+	progress.modelsLoaded = m_modelsLoaded;
+	progress.modelsTotal = m_modelsTotal;
+	progress.meshesLoaded = m_meshesLoaded;
+	progress.bytesRead = m_bytesRead;
+	return progress;
+}
+
+void CLoadContext::checkCancelled() const
+{
+	if (m_cancelled)
+		throw CLoadCancelled();
+}
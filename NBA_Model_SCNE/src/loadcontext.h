@@ -0,0 +1,95 @@
+/* State of a single scene load - working directory, options, file lookups and load-time memory.
+   Every CSceneFile owns one so scenes can load side by side, models keep it alive for data decoded later. */
+
+#include <string>
+#include <unordered_map>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <memory_resource>
+#pragma once
+
+#define LOAD_ARENA_BLOCK 0x10000
+
+class CThreadPool;
+
+struct StLoadOptions
+{
+	bool includeLods = false; // load lower level prims as '_LOD' meshes
+	bool debugLogs   = false;
+};
+
+enum enLoadStage {
+	LOAD_QUEUED = 0,
+	LOAD_READ_JSON,
+	LOAD_SCAN_FILES,
+	LOAD_MODELS,
+	LOAD_DONE,
+	LOAD_FAILED,
+	LOAD_CANCELLED
+};
+
+// Plain layout - copied out to Python as is
+struct StLoadProgress
+{
+	int stage = LOAD_QUEUED;
+	int modelsLoaded = 0;
+	int modelsTotal = 0;
+	int meshesLoaded = 0;
+	uint64_t bytesRead = 0; // scene json + data binaries read so far
+};
+
+// Thrown by the loading thread at the next buffer once a load was cancelled
+class CLoadCancelled : public std::runtime_error
+{
+public:
+	CLoadCancelled() : std::runtime_error("Scene load cancelled.") {}
+};
+
+class CLoadContext
+{
+public:
+	CLoadContext(const std::string& workingDir, const StLoadOptions& options = StLoadOptions());
+
+public:
+	const std::string& getWorkingDir() const { return m_workingDir; }
+	const StLoadOptions& getOptions() const { return m_options; }
+	std::pmr::memory_resource* getArena() { return &m_arena; }
+	CThreadPool& getThreadPool() const { return *m_pool; }
+
+	// Case insensitive lookup below the working directory - the folder is walked once per load
+	std::string findFile(const std::string& filename) const;
+	void scanFiles() const; // walks the folder up front instead of on the first lookup
+
+	// Progress and cancellation - written by the loading thread, safe to read or cancel from any other
+	void setStage(const enLoadStage stage) { m_stage = stage; }
+	void addModelsTotal(const int count) { m_modelsTotal += count; }
+	void addModel(const int numMeshes);
+	void addBytesRead(const uint64_t bytes) { m_bytesRead += bytes; }
+	StLoadProgress getProgress() const;
+
+	void cancel() { m_cancelled = true; }
+	bool isCancelled() const { return m_cancelled; }
+	void checkCancelled() const; // throws CLoadCancelled
+
+private:
+	void indexFiles() const;
+
+private:
+	std::string m_workingDir;
+	StLoadOptions m_options;
+	std::pmr::monotonic_buffer_resource m_arena; // not thread safe - only the loading thread allocates from it
+	CThreadPool* m_pool;
+
+	mutable std::mutex m_fileMutex;
+	mutable bool m_indexed;
+	mutable std::unordered_map<std::string, std::string> m_files; // lower case file name -> first path found
+
+	std::atomic<int> m_stage;
+	std::atomic<int> m_modelsLoaded;
+	std::atomic<int> m_modelsTotal;
+	std::atomic<int> m_meshesLoaded;
+	std::atomic<uint64_t> m_bytesRead;
+	std::atomic<bool> m_cancelled;
+};
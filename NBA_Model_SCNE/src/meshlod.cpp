@@ -0,0 +1,292 @@
+#include <meshlod.h>
+#include <meshprimitive.h>
+#include <meshopt.h>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+// Symmetric 4x4 plane quadric - upper triangle, row major
+struct StQuadric
+{
+	double a[10] = { 0 };
+
+	void addPlane(const Vec3& n, const double d, const double weight)
+	{
+		const double p[4] = { n.x, n.y, n.z, d };
+		int k = 0;
+		for (int i = 0; i < 4; i++)
+			for (int j = i; j < 4; j++)
+				a[k++] += weight * p[i] * p[j];
+	}
+
+	void operator+=(const StQuadric& q)
+	{
+		for (int i = 0; i < 10; i++)
+			a[i] += q.a[i];
+	}
+
+	double error(const Vec3& v) const
+	{
+		double x = v.x, y = v.y, z = v.z;
+		return a[0] * x * x + 2 * a[1] * x * y + 2 * a[2] * x * z + 2 * a[3] * x
+			+ a[4] * y * y + 2 * a[5] * y * z + 2 * a[6] * y
+			+ a[7] * z * z + 2 * a[8] * z
+			+ a[9];
+	}
+};
+
+struct StCollapse
+{
+	double cost;
+	uint32_t from;
+	uint32_t to;
+};
+
+static Vec3 getPosition(const Mesh& mesh, const uint32_t vtx)
+{
+	const float* p = &mesh.vertices[vtx * mesh.vertexComponents];
+	return Vec3{ p[0], p[1], p[2] };
+}
+
+// Summed absolute weight difference of two vertices over the union of their joints
+static float getSkinDistance(const Skin& skin, const uint32_t a, const uint32_t b)
+{
+	float dist = 0.0f;
+	for (uint32_t i = skin.offsets[a]; i < skin.offsets[a + 1]; i++)
+	{
+		float other = 0.0f;
+		for (uint32_t j = skin.offsets[b]; j < skin.offsets[b + 1]; j++)
+			other = (skin.joints[j] == skin.joints[i]) ? skin.weights[j] : other;
+		dist += std::abs(skin.weights[i] - other);
+	}
+
+	for (uint32_t j = skin.offsets[b]; j < skin.offsets[b + 1]; j++)
+	{
+		bool shared = false;
+		for (uint32_t i = skin.offsets[a]; i < skin.offsets[a + 1]; i++)
+			shared |= (skin.joints[j] == skin.joints[i]);
+		dist += (shared) ? 0.0f : skin.weights[j];
+	}
+
+	return dist;
+}
+
+static uint64_t getEdgeKey(uint32_t a, uint32_t b)
+{
+	return (a < b) ? (uint64_t(a) << 32) | b : (uint64_t(b) << 32) | a;
+}
+
+void MeshLod::simplify(const Mesh& mesh, const std::vector<Triangle>& src, const size_t targetTris, std::vector<Triangle>& dst)
+{
+	size_t numVerts = mesh.vertices.size() / mesh.vertexComponents;
+	bool useSkin = (mesh.skin.getNumVerts() == numVerts);
+
+	dst.clear();
+	dst.reserve(src.size());
+	for (auto& tri : src)
+		if (tri[0] != tri[1] && tri[1] != tri[2] && tri[0] != tri[2])
+			dst.push_back(tri);
+
+	// Area weighted face quadrics
+	std::vector<StQuadric> quadrics(numVerts);
+	for (auto& tri : dst)
+	{
+		Vec3 p0 = ::getPosition(mesh, tri[0]);
+		Vec3 n = Vec3::cross(::getPosition(mesh, tri[1]) - p0, ::getPosition(mesh, tri[2]) - p0);
+		float area = std::sqrt(Vec3::dot(n, n));
+		if (area <= 0.0f)
+			continue;
+
+		n /= area;
+		for (auto& vtx : tri)
+			quadrics[vtx].addPlane(n, -Vec3::dot(n, p0), area * 0.5f);
+	}
+
+	// Edges used by a single triangle are borders or attribute seams - lock their vertices
+	std::vector<uint64_t> edges;
+	edges.reserve(dst.size() * 3);
+	for (auto& tri : dst)
+		for (int i = 0; i < 3; i++)
+			edges.push_back(::getEdgeKey(tri[i], tri[(i + 1) % 3]));
+	std::sort(edges.begin(), edges.end());
+
+	std::vector<bool> locked(numVerts, false);
+	for (size_t i = 0; i < edges.size();)
+	{
+		size_t run = i;
+		while (run < edges.size() && edges[run] == edges[i])
+			run++;
+
+		if (run - i == 1) {
+			locked[edges[i] >> 32] = true;
+			locked[edges[i] & UINT32_MAX] = true;
+		}
+		i = run;
+	}
+	edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+	std::vector<uint32_t> adjOffsets(numVerts + 1);
+	std::vector<uint32_t> adjacency;
+	std::vector<uint32_t> remap(numVerts);
+	std::vector<bool> touched(numVerts);
+	std::vector<StCollapse> collapses;
+
+	while (dst.size() > targetTris)
+	{
+		// Vertex -> triangle adjacency of the current level
+		std::fill(adjOffsets.begin(), adjOffsets.end(), 0);
+		for (auto& tri : dst)
+			for (auto& vtx : tri)
+				adjOffsets[vtx + 1]++;
+		for (size_t v = 0; v < numVerts; v++)
+			adjOffsets[v + 1] += adjOffsets[v];
+
+		adjacency.resize(dst.size() * 3);
+		std::vector<uint32_t> fill(adjOffsets.begin(), adjOffsets.end() - 1);
+		for (size_t t = 0; t < dst.size(); t++)
+			for (auto& vtx : dst[t])
+				adjacency[fill[vtx]++] = static_cast<uint32_t>(t);
+
+		// Cheapest valid direction of every remaining edge
+		collapses.clear();
+		for (auto& key : edges)
+		{
+			uint32_t a = key >> 32;
+			uint32_t b = key & UINT32_MAX;
+			if (locked[a] && locked[b])
+				continue;
+			if (useSkin && ::getSkinDistance(mesh.skin, a, b) > LOD_SKIN_TOLERANCE)
+				continue;
+
+			StQuadric q = quadrics[a];
+			q += quadrics[b];
+
+			double costAB = (locked[a]) ? DBL_MAX : q.error(::getPosition(mesh, b));
+			double costBA = (locked[b]) ? DBL_MAX : q.error(::getPosition(mesh, a));
+			collapses.push_back((costAB <= costBA) ? StCollapse{ costAB, a, b } : StCollapse{ costBA, b, a });
+		}
+
+		std::sort(collapses.begin(), collapses.end(), [](const StCollapse& l, const StCollapse& r) { return l.cost < r.cost; });
+
+		// Independent collapses only - neighbours of a moved vertex wait for the next pass
+		for (size_t v = 0; v < numVerts; v++)
+			remap[v] = static_cast<uint32_t>(v);
+		std::fill(touched.begin(), touched.end(), false);
+
+		size_t removeGoal = dst.size() - targetTris;
+		size_t removed = 0;
+		size_t passLimit = std::max<size_t>(1, collapses.size() / 3);
+
+		for (size_t c = 0; c < collapses.size() && c < passLimit && removed < removeGoal; c++)
+		{
+			auto& edge = collapses[c];
+			if (touched[edge.from] || touched[edge.to])
+				continue;
+
+			// Reject collapses that flip a surviving triangle
+			bool flips = false;
+			size_t shared = 0;
+			Vec3 target = ::getPosition(mesh, edge.to);
+
+			for (uint32_t k = adjOffsets[edge.from]; k < adjOffsets[edge.from + 1] && !flips; k++)
+			{
+				auto& tri = dst[adjacency[k]];
+				if (tri[0] == edge.to || tri[1] == edge.to || tri[2] == edge.to) {
+					shared++;
+					continue;
+				}
+
+				Vec3 p[3], q[3];
+				for (int i = 0; i < 3; i++) {
+					p[i] = ::getPosition(mesh, tri[i]);
+					q[i] = (tri[i] == edge.from) ? target : p[i];
+				}
+
+				Vec3 before = Vec3::cross(p[1] - p[0], p[2] - p[0]);
+				Vec3 after = Vec3::cross(q[1] - q[0], q[2] - q[0]);
+				float cosAngle = Vec3::dot(before, after) / std::sqrt(Vec3::dot(before, before) * Vec3::dot(after, after));
+				flips = !(cosAngle > LOD_MAX_FACE_TURN); // also catches degenerate (NaN) faces
+			}
+
+			if (flips || shared == 0)
+				continue;
+
+			remap[edge.from] = edge.to;
+			quadrics[edge.to] += quadrics[edge.from];
+			removed += shared;
+
+			for (uint32_t k = adjOffsets[edge.from]; k < adjOffsets[edge.from + 1]; k++)
+				for (auto& vtx : dst[adjacency[k]])
+					touched[vtx] = true;
+		}
+
+		if (removed == 0)
+			break;
+
+		// Apply the pass and drop collapsed faces
+		size_t write = 0;
+		for (auto& tri : dst)
+		{
+			Triangle face = { remap[tri[0]], remap[tri[1]], remap[tri[2]] };
+			if (face[0] != face[1] && face[1] != face[2] && face[0] != face[2])
+				dst[write++] = face;
+		}
+		dst.resize(write);
+
+		for (auto& key : edges)
+			key = ::getEdgeKey(remap[key >> 32], remap[key & UINT32_MAX]);
+		std::sort(edges.begin(), edges.end());
+		edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+		edges.erase(std::remove_if(edges.begin(), edges.end(), [](uint64_t key) { return (key >> 32) == (key & UINT32_MAX); }), edges.end());
+	}
+}
+
+void MeshLod::buildLodChain(Mesh& mesh, const std::vector<float>& ratios)
+{
+	mesh.lods.clear();
+	mesh.lodTriangles.clear();
+
+	size_t numVerts = mesh.vertices.size() / mesh.vertexComponents;
+	size_t numTris = mesh.triangles.size();
+	if (ratios.empty() || numTris == 0)
+		return;
+
+	for (auto& tri : mesh.triangles)
+		if (tri[0] >= numVerts || tri[1] >= numVerts || tri[2] >= numVerts) {
+			printf("\n[MeshLod] WARNING: Skipped '%s' - triangles reference missing vertices", mesh.name.c_str());
+			return;
+		}
+
+	mesh.lods.push_back({ 0, static_cast<int>(numTris * 3) });
+
+	// Each level is simplified from the previous one
+	std::vector<Triangle> previous = mesh.triangles;
+	std::vector<Triangle> level;
+
+	for (auto& ratio : ratios)
+	{
+		size_t target = std::max<size_t>(1, static_cast<size_t>(numTris * ratio));
+		if (target >= previous.size())
+			continue;
+
+		MeshLod::simplify(mesh, previous, target, level);
+		if (level.empty() || level.size() >= previous.size())
+			break;
+
+		if (OPTIMIZE_VERTEX_ORDER)
+			MeshOpt::optimizeVertexCache(level, 0, level.size(), numVerts);
+
+		int begin = static_cast<int>((numTris + mesh.lodTriangles.size()) * 3);
+		mesh.lodTriangles.insert(mesh.lodTriangles.end(), level.begin(), level.end());
+		mesh.lods.push_back({ begin, static_cast<int>(level.size() * 3) });
+
+		printf("\n[MeshLod] %s LOD%zu: %zu -> %zu triangles (target %zu)",
+			mesh.name.c_str(), mesh.lods.size() - 1, numTris, level.size(), target);
+
+		previous.swap(level);
+	}
+
+	// Nothing could be reduced - export a single level as before
+	if (mesh.lods.size() == 1)
+		mesh.lods.clear();
+}
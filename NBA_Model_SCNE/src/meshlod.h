@@ -0,0 +1,17 @@
+/* Export-time LOD generation - quadric error edge collapse onto existing vertices so every level shares one vertex buffer */
+
+#include <meshstructs.h>
+#pragma once
+
+#define LOD_SKIN_TOLERANCE 0.25f // max summed weight difference between two vertices that may be merged
+#define LOD_MAX_FACE_TURN  0.25f // min cosine between a face normal before and after a collapse
+
+namespace MeshLod
+{
+	// Collapses edges of 'src' until it has at most 'targetTris' triangles or no valid collapse is left.
+	// Vertices on open edges (borders and UV/normal seams) are never moved.
+	void simplify(const Mesh& mesh, const std::vector<Triangle>& src, const size_t targetTris, std::vector<Triangle>& dst);
+
+	// Fills mesh.lods / mesh.lodTriangles with one level per ratio of the full triangle count (e.g. 0.5, 0.25)
+	void buildLodChain(Mesh& mesh, const std::vector<float>& ratios);
+}
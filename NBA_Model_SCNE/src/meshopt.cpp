@@ -0,0 +1,209 @@
+#include <meshopt.h>
+#include <meshprimitive.h>
+#include <algorithm>
+
+float MeshOpt::computeACMR(const std::vector<Triangle>& triangles, const size_t numVerts, const int cacheSize)
+{
+	if (triangles.empty())
+		return 0.0f;
+
+	// A vertex is resident while fewer than 'cacheSize' misses happened since it was loaded
+	std::vector<uint32_t> stamp(numVerts, 0);
+	uint32_t time = cacheSize + 1;
+	size_t misses = 0;
+
+	for (auto& tri : triangles)
+		for (auto& vtx : tri)
+			if (vtx < numVerts && time - stamp[vtx] > uint32_t(cacheSize))
+			{
+				stamp[vtx] = time++;
+				misses++;
+			}
+
+	return float(misses) / float(triangles.size());
+}
+
+void MeshOpt::optimizeVertexCache(std::vector<Triangle>& triangles, const size_t first, const size_t last,
+	const size_t numVerts, const int cacheSize)
+{
+	if (last <= first)
+		return;
+
+	size_t numTris = last - first;
+
+	// Vertex -> triangle adjacency of the range (CSR) and live triangle counts
+	std::vector<uint32_t> live(numVerts, 0);
+	std::vector<uint32_t> adjOffsets(numVerts + 1, 0);
+	std::vector<uint32_t> adjacency(numTris * 3);
+
+	for (size_t i = first; i < last; i++)
+		for (auto& vtx : triangles[i])
+			live[vtx]++;
+
+	for (size_t v = 0; v < numVerts; v++)
+		adjOffsets[v + 1] = adjOffsets[v] + live[v];
+
+	std::vector<uint32_t> fill(adjOffsets.begin(), adjOffsets.end() - 1);
+	for (size_t i = first; i < last; i++)
+		for (auto& vtx : triangles[i])
+			adjacency[fill[vtx]++] = static_cast<uint32_t>(i - first);
+
+	std::vector<uint32_t> stamp(numVerts, 0);
+	std::vector<bool> emitted(numTris, false);
+	std::vector<uint32_t> deadEnds;
+	std::vector<uint32_t> candidates;
+	std::vector<Triangle> output;
+	output.reserve(numTris);
+	deadEnds.reserve(numTris * 3);
+
+	uint32_t time = cacheSize + 1;
+	size_t cursor = 0;
+	int64_t fan = triangles[first][0];
+
+	while (fan >= 0)
+	{
+		// Emit every remaining triangle around the fanning vertex
+		candidates.clear();
+		for (uint32_t k = adjOffsets[fan]; k < adjOffsets[fan + 1]; k++)
+		{
+			uint32_t tri = adjacency[k];
+			if (emitted[tri])
+				continue;
+
+			auto& face = triangles[first + tri];
+			for (auto& vtx : face)
+			{
+				deadEnds.push_back(vtx);
+				candidates.push_back(vtx);
+				live[vtx]--;
+
+				if (time - stamp[vtx] > uint32_t(cacheSize))
+					stamp[vtx] = time++;
+			}
+
+			output.push_back(face);
+			emitted[tri] = true;
+		}
+
+		// Next fan (Tipsify priority): the oldest candidate that still stays in cache for all of its remaining triangles
+		fan = -1;
+		int64_t best = -1;
+		for (auto& vtx : candidates)
+		{
+			if (live[vtx] == 0)
+				continue;
+
+			int64_t priority = 0;
+			if (time - stamp[vtx] + 2 * live[vtx] <= uint32_t(cacheSize))
+				priority = time - stamp[vtx];
+
+			if (priority > best) {
+				best = priority;
+				fan = vtx;
+			}
+		}
+
+		// Dead end - pop the most recently used vertex with live triangles off the stack, then scan for any live one
+		while (fan < 0 && !deadEnds.empty())
+		{
+			uint32_t vtx = deadEnds.back();
+			deadEnds.pop_back();
+			if (live[vtx] > 0)
+				fan = vtx;
+		}
+
+		for (; fan < 0 && cursor < numVerts; cursor++)
+			if (live[cursor] > 0)
+				fan = cursor;
+	}
+
+	std::copy(output.begin(), output.end(), triangles.begin() + first);
+}
+
+template <typename T>
+static void takeStream(std::vector<T>& dst, std::vector<T>& src)
+{
+	// Streams that could not be remapped (size mismatch) are left untouched
+	if (!src.empty())
+		dst.swap(src);
+}
+
+void MeshOpt::optimizeVertexFetch(Mesh& mesh)
+{
+	size_t numVerts = mesh.vertices.size() / mesh.vertexComponents;
+	if (numVerts == 0)
+		return;
+
+	constexpr uint32_t UNUSED = UINT32_MAX;
+	std::vector<uint32_t> remap(numVerts, UNUSED);
+	std::vector<uint32_t> order;
+	order.reserve(numVerts);
+
+	for (auto& tri : mesh.triangles)
+		for (auto& vtx : tri)
+		{
+			uint32_t& index = remap[vtx];
+			if (index == UNUSED) {
+				index = static_cast<uint32_t>(order.size());
+				order.push_back(vtx);
+			}
+			vtx = index;
+		}
+
+	// Unreferenced vertices move to the tail so stream lengths stay the same
+	for (uint32_t vtx = 0; vtx < numVerts; vtx++)
+		if (remap[vtx] == UNUSED)
+			order.push_back(vtx);
+
+	Mesh ordered;
+	GeomDef::gatherVertices(mesh, order, ordered);
+
+	::takeStream(mesh.vertices, ordered.vertices);
+	::takeStream(mesh.normals, ordered.normals);
+	::takeStream(mesh.binormals, ordered.binormals);
+	::takeStream(mesh.tangents, ordered.tangents);
+	::takeStream(mesh.tangent_frames, ordered.tangent_frames);
+	::takeStream(mesh.normalIndices, ordered.normalIndices);
+	::takeStream(mesh.tangentIndices, ordered.tangentIndices);
+
+	for (size_t i = 0; i < mesh.uvs.size(); i++)
+		::takeStream(mesh.uvs[i].map, ordered.uvs[i].map);
+
+	if (!ordered.skin.empty())
+		std::swap(mesh.skin, ordered.skin);
+}
+
+void MeshOpt::optimizeMesh(Mesh& mesh)
+{
+	size_t numVerts = mesh.vertices.size() / mesh.vertexComponents;
+	auto& tris = mesh.triangles;
+	if (numVerts == 0 || tris.empty())
+		return;
+
+	bool isValid = std::all_of(tris.begin(), tris.end(), [numVerts](const Triangle& tri) {
+		return tri[0] < numVerts && tri[1] < numVerts && tri[2] < numVerts;
+	});
+
+	if (!isValid) {
+		printf("\n[MeshOpt] WARNING: Skipped '%s' - triangles reference missing vertices", mesh.name.c_str());
+		return;
+	}
+
+	float acmr = MeshOpt::computeACMR(tris, numVerts);
+
+	// Triangles only move within their group so material ranges stay intact
+	if (mesh.groups.empty())
+		MeshOpt::optimizeVertexCache(tris, 0, tris.size(), numVerts);
+
+	for (auto& group : mesh.groups)
+	{
+		size_t first = std::min<size_t>(group.begin / 3, tris.size());
+		size_t last = std::min<size_t>((group.begin + group.count) / 3, tris.size());
+		MeshOpt::optimizeVertexCache(tris, first, last, numVerts);
+	}
+
+	MeshOpt::optimizeVertexFetch(mesh);
+
+	printf("\n[MeshOpt] %s: ACMR %.3f -> %.3f (%zu triangles, %zu vertices)",
+		mesh.name.c_str(), acmr, MeshOpt::computeACMR(tris, numVerts), tris.size(), numVerts);
+}
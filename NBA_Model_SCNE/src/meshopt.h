@@ -0,0 +1,22 @@
+/* Export-time mesh ordering - triangle order for post-transform cache reuse, vertex order for fetch locality */
+
+#include <meshstructs.h>
+#pragma once
+
+#define VERTEX_CACHE_SIZE 16 // FIFO entries assumed for both the reorder and the ACMR report
+
+namespace MeshOpt
+{
+	// Average cache miss ratio (transformed vertices per triangle) of a FIFO post-transform cache
+	float computeACMR(const std::vector<Triangle>& triangles, const size_t numVerts, const int cacheSize = VERTEX_CACHE_SIZE);
+
+	// Tipsify (Sander et al. 2007) - reorders triangles [first, last) in place
+	void optimizeVertexCache(std::vector<Triangle>& triangles, const size_t first, const size_t last,
+		const size_t numVerts, const int cacheSize = VERTEX_CACHE_SIZE);
+
+	// Renumbers vertices in first-use order and remaps every per-vertex stream (uvs, skin, normals...)
+	void optimizeVertexFetch(Mesh& mesh);
+
+	// Runs both passes per face group and reports ACMR before/after
+	void optimizeMesh(Mesh& mesh);
+}
@@ -2,40 +2,13 @@
 #include <databuffer.h>
 #include <common.h>
 #include <bin_codec.h>
+#include <algorithm>
+#include <cmath>
 
-bool USE_DEBUG_LOGS   = false;
-bool INCLUDE_LODS     = false;
-uint8_t WEIGHT_BITS   = 16;
-
-void decodeOctahedralNorms(CDataBuffer* tanFrameBf, Mesh& mesh)
-{
-	if (tanFrameBf->getFormat() != "R10G10B10A2_UINT")
-		return;
-
-	Vec3 normal;
-	Vec4 encoded;
-	auto& data = tanFrameBf->data;
-
-	for (int i = 0; i < data.size(); i += 4)
-	{
-		encoded = { data[i + 0], data[i + 1], data[i + 2], data[i + 3] };
-
-		normal.x = (encoded.x * (1.0f / 1023.0f)) * 2.0f - 1.0f;
-		normal.y = (encoded.y * (1.0f / 1023.0f)) * 2.0f - 1.0f;
-		normal.z = 1.0f - fabsf(normal.x) - fabsf(normal.y);
-
-		float t = fmaxf(-normal.z, 0.0f);
-		normal.x += (normal.x >= 0.0f) ? -t : t;
-		normal.y += (normal.y >= 0.0f) ? -t : t;
-		normal.normalize();
-
-		// push vertex data
-		mesh.normals.push_back(normal.x);
-		mesh.normals.push_back(normal.y);
-		mesh.normals.push_back(normal.z);
-	};
-
-};
+bool OPTIMIZE_VERTEX_ORDER = false;
+float POSITION_MAX_ERROR = 0.0f;
+bool INTERLEAVE_VERTEX_STREAMS = false;
+std::vector<float> LOD_RATIOS;
 
 void StGeoLOD::parse(JSON& obj)
 {
@@ -106,16 +79,17 @@ void StGeoPrim::load(JSON& obj)
 	}
 }
 
-void GeomDef::pushPrimLods(StGeoPrim& prim, std::vector<StGeoPrim>& prim_vec)
+void GeomDef::pushPrimLods(StGeoPrim&& prim, std::pmr::vector<StGeoPrim>& prim_vec, const bool includeLods)
 {
 	if (prim.lods.empty())
 	{
 		// No lods - only push main prim geo
-		prim_vec.push_back(prim);
+		prim_vec.push_back(std::move(prim));
 		return;
 	}
 
-	int num_lods = (INCLUDE_LODS) ? prim.lods.size() : 1;
+	int num_lods = (includeLods) ? prim.lods.size() : 1;
+	prim_vec.reserve(prim_vec.size() + num_lods);
 
 	for (int i = 0; i < num_lods; i++)
 	{
@@ -128,12 +102,22 @@ void GeomDef::pushPrimLods(StGeoPrim& prim, std::vector<StGeoPrim>& prim_vec)
 
 		// Format and push to scene.
 		newPrim.name += (i > 0) ? "_LOD" + std::to_string(i) : "";
-		prim_vec.push_back(newPrim);
+		prim_vec.push_back(std::move(newPrim));
 	}
 }
 
 void GeomDef::setMeshVtxs(CDataBuffer* posBf, Mesh& mesh)
 {
+	// Fused kernel already wrote final coords - take ownership, no further passes
+	if (posBf->hasFusedData())
+	{
+		auto& tfm = posBf->getAttribTfm();
+		mesh.vertexComponents = tfm.components;
+		mesh.isBlenderAligned = tfm.toBlender;
+		mesh.vertices = std::move(posBf->data);
+		return;
+	}
+
 	// calculate total components
 	BinaryCodec codec(posBf->getEncoding(), posBf->getType());
 	auto numChannels = codec.num_channels();
@@ -191,6 +175,14 @@ void GeomDef::addMeshUVMap(CDataBuffer* texBf, Mesh& mesh)
 	/* Format uv coord mesh data - ignore every W position coord */
 	UVMap channel{ texBf->id };
 
+	// Fused kernel already applied scale/offset and the V flip
+	if (texBf->hasFusedData())
+	{
+		channel.map = std::move(texBf->data);
+		mesh.uvs.push_back(channel);
+		return;
+	}
+
 	for (int i = 0; i < texBf->data.size(); i++)
 	{
 		auto coord = texBf->data[i];
@@ -219,8 +211,234 @@ void GeomDef::calculateVtxNormals(CDataBuffer* tanBf, Mesh& mesh)
 	if (size == 0 || size % 4 != 0)
 		return;
 
-	// Unpack data
+	// Unpack data - normals were decoded from the packed frames on load
 	mesh.tangent_frames = tanBf->data;
-	::decodeOctahedralNorms(tanBf, mesh);
+	mesh.normals = tanBf->frameNormals;
+}
+
+size_t GeomDef::removeInvalidTriangles(Mesh& mesh)
+{
+	uint32_t numVerts = mesh.vertices.size() / mesh.vertexComponents;
+	auto isValid = [numVerts](const Triangle& tri) {
+		return tri[0] < numVerts && tri[1] < numVerts && tri[2] < numVerts;
+	};
+
+	auto& tris = mesh.triangles;
+	if (std::all_of(tris.begin(), tris.end(), isValid))
+		return 0;
+
+	size_t numTris = tris.size();
+	if (mesh.groups.empty()) {
+		tris.erase(std::remove_if(tris.begin(), tris.end(), [&](const Triangle& tri) { return !isValid(tri); }), tris.end());
+		printf("\n[GeomDef] WARNING: Removed %zu triangles with invalid vertex indices", numTris - tris.size());
+		return numTris - tris.size();
+	}
+
+	// Compact in place - groups are sequential ranges so their views shift down with the array
+	size_t write = 0;
+	size_t numInvalid = 0;
+	size_t numGrouped = 0;
+
+	for (auto& group : mesh.groups)
+	{
+		size_t first = std::min<size_t>(group.begin / 3, numTris);
+		size_t last = std::min<size_t>((group.begin + group.count) / 3, numTris);
+		size_t newBegin = write;
+		numGrouped += last - std::min(first, last);
+
+		for (size_t i = first; i < last; i++)
+		{
+			if (isValid(tris[i]))
+				tris[write++] = tris[i];
+			else
+				numInvalid++;
+		}
+
+		group.begin = newBegin * 3;
+		group.count = (write - newBegin) * 3;
+	}
+
+	// Compaction also drops anything not covered by a group range - report it apart from bad indices
+	size_t numUngrouped = numTris - std::min(numGrouped, numTris);
+	if (numInvalid)
+		printf("\n[GeomDef] WARNING: Removed %zu triangles with invalid vertex indices (max vertex: %u)",
+			numInvalid, numVerts - 1);
+	if (numUngrouped)
+		printf("\n[GeomDef] WARNING: Removed %zu triangles outside of any face group", numUngrouped);
+
+	tris.resize(write);
+	return numTris - write;
+}
+
+// Copies the per-vertex values of 'order' (old vertex ids) into a compacted attribute
+template <typename T>
+static void gatherVertexAttrib(const std::vector<T>& src, const std::vector<uint32_t>& order,
+	const size_t numVerts, const size_t stride, std::vector<T>& dst)
+{
+	dst.clear();
+	if (src.size() < numVerts * stride)
+		return;
+
+	dst.resize(order.size() * stride);
+	for (size_t i = 0; i < order.size(); i++)
+		std::copy_n(&src[order[i] * stride], stride, &dst[i * stride]);
 }
 
+// Values per vertex of a generated attribute - MikkTSpace writes xyzw tangents and a single binormal sign
+template <typename T>
+static size_t getVertexStride(const std::vector<T>& src, const size_t numVerts)
+{
+	return (numVerts) ? src.size() / numVerts : 0;
+}
+
+void GeomDef::gatherVertices(const Mesh& mesh, const std::vector<uint32_t>& order, Mesh& dst)
+{
+	size_t numVerts = mesh.vertices.size() / mesh.vertexComponents;
+
+	::gatherVertexAttrib(mesh.vertices, order, numVerts, mesh.vertexComponents, dst.vertices);
+	::gatherVertexAttrib(mesh.normals, order, numVerts, 3, dst.normals);
+	::gatherVertexAttrib(mesh.binormals, order, numVerts, ::getVertexStride(mesh.binormals, numVerts), dst.binormals);
+	::gatherVertexAttrib(mesh.tangents, order, numVerts, ::getVertexStride(mesh.tangents, numVerts), dst.tangents);
+	::gatherVertexAttrib(mesh.tangent_frames, order, numVerts, 4, dst.tangent_frames);
+	::gatherVertexAttrib(mesh.normalIndices, order, numVerts, 1, dst.normalIndices);
+	::gatherVertexAttrib(mesh.tangentIndices, order, numVerts, 1, dst.tangentIndices);
+
+	dst.uvs.clear();
+	for (auto& uvMap : mesh.uvs)
+	{
+		UVMap channel = { uvMap.name, {}, uvMap.baseU, uvMap.baseV };
+		::gatherVertexAttrib(uvMap.map, order, numVerts, 2, channel.map);
+		dst.uvs.push_back(std::move(channel));
+	}
+
+	// Skin influence ranges
+	auto& skin = mesh.skin;
+	dst.skin.clear();
+	if (skin.getNumVerts() == numVerts)
+	{
+		dst.skin.jointNames = skin.jointNames;
+		for (auto& vtx : order)
+		{
+			for (uint32_t k = skin.offsets[vtx]; k < skin.offsets[vtx + 1]; k++)
+				dst.skin.pushInfluence(skin.joints[k], skin.weights[k]);
+			dst.skin.endVertex();
+		}
+	}
+}
+
+std::shared_ptr<Mesh> GeomDef::createGroupMesh(const Mesh& mesh, const FaceGroup& group)
+{
+	auto groupMesh = std::make_shared<Mesh>();
+	size_t numVerts = mesh.vertices.size() / mesh.vertexComponents;
+	size_t numTris = mesh.triangles.size();
+	size_t first = std::min<size_t>(group.begin / 3, numTris);
+	size_t last = std::min<size_t>((group.begin + group.count) / 3, numTris);
+
+	// Remap referenced vertices in first-use order - single pass over the group's range
+	constexpr uint32_t UNUSED = UINT32_MAX;
+	std::vector<uint32_t> remap(numVerts, UNUSED);
+	std::vector<uint32_t> order;
+	order.reserve(std::min(numVerts, (last - first) * 3));
+
+	groupMesh->triangles.reserve(last - first);
+	for (size_t i = first; i < last; i++)
+	{
+		auto& src = mesh.triangles[i];
+		if (src[0] >= numVerts || src[1] >= numVerts || src[2] >= numVerts)
+			continue;
+
+		Triangle& dst = groupMesh->triangles.emplace_back();
+		for (int j = 0; j < 3; j++)
+		{
+			uint32_t& index = remap[src[j]];
+			if (index == UNUSED) {
+				index = static_cast<uint32_t>(order.size());
+				order.push_back(src[j]);
+			}
+			dst[j] = index;
+		}
+	}
+
+	// Mesh attributes - only the referenced vertices are copied, 'order' is kept to scatter updates back
+	GeomDef::gatherVertices(mesh, order, *groupMesh);
+
+	// Shared mesh properties
+	groupMesh->name = group.name;
+	groupMesh->definition = mesh.definition;
+	groupMesh->bounds = mesh.bounds;
+	groupMesh->material = group.material;
+	groupMesh->originalFormat = mesh.originalFormat;
+	groupMesh->vertexComponents = mesh.vertexComponents;
+	groupMesh->isBlenderAligned = mesh.isBlenderAligned;
+	groupMesh->vertex_ref = mesh.vertex_ref;
+	groupMesh->normals_ref = mesh.normals_ref;
+	groupMesh->texcoord_ref = mesh.texcoord_ref;
+	groupMesh->hasSplitIndices = mesh.hasSplitIndices;
+	groupMesh->uniqueNormals = mesh.uniqueNormals;
+	groupMesh->uniqueTangents = mesh.uniqueTangents;
+	groupMesh->normalIndexRef = mesh.normalIndexRef;
+	groupMesh->tangentIndexRef = mesh.tangentIndexRef;
+	groupMesh->morphs = mesh.morphs;
+	groupMesh->sourceVertices = std::move(order);
+
+	FaceGroup localGroup = group;
+	localGroup.begin = 0;
+	localGroup.count = static_cast<int>(groupMesh->triangles.size() * 3);
+	groupMesh->groups.push_back(localGroup);
+
+	return groupMesh;
+}
+
+// FNV-1a over one quantized coordinate
+static void hashCoord(uint64_t& hash, const float value)
+{
+	int64_t cell = static_cast<int64_t>(std::floor(value / FINGERPRINT_GRID + 0.5f));
+	for (int i = 0; i < 8; i++) {
+		hash ^= uint64_t(cell >> (i * 8)) & 0xFF;
+		hash *= 1099511628211ULL;
+	}
+}
+
+static Vec3 getGamePosition(const Mesh& mesh, const size_t vtx)
+{
+	const float* p = &mesh.vertices[vtx * mesh.vertexComponents];
+
+	// Undo the (x, -z, y) Blender swap so both load paths agree
+	return (mesh.isBlenderAligned) ? Vec3{ p[0], p[2], -p[1] } : Vec3{ p[0], p[1], p[2] };
+}
+
+MeshFingerprint GeomDef::computeFingerprint(const Mesh& mesh)
+{
+	MeshFingerprint print;
+	size_t numVerts = mesh.vertices.size() / mesh.vertexComponents;
+	print.numVerts = static_cast<uint32_t>(numVerts);
+	print.numTris = static_cast<uint32_t>(mesh.triangles.size());
+	print.boundsHash = 14695981039346656037ULL;
+	print.sampleHash = 14695981039346656037ULL;
+	if (numVerts == 0)
+		return print;
+
+	Vec3 lo = ::getGamePosition(mesh, 0);
+	Vec3 hi = lo;
+	for (size_t i = 1; i < numVerts; i++)
+	{
+		Vec3 p = ::getGamePosition(mesh, i);
+		lo = Vec3{ std::min(lo.x, p.x), std::min(lo.y, p.y), std::min(lo.z, p.z) };
+		hi = Vec3{ std::max(hi.x, p.x), std::max(hi.y, p.y), std::max(hi.z, p.z) };
+	}
+
+	for (float value : { lo.x, lo.y, lo.z, hi.x, hi.y, hi.z })
+		::hashCoord(print.boundsHash, value);
+
+	// Mirrored meshes (left/right shoes) share counts and often bounds size, not sample positions
+	size_t step = std::max<size_t>(1, numVerts / FINGERPRINT_SAMPLES);
+	for (size_t i = 0; i < numVerts; i += step)
+	{
+		Vec3 p = ::getGamePosition(mesh, i);
+		::hashCoord(print.sampleHash, p.x);
+		::hashCoord(print.sampleHash, p.y);
+		::hashCoord(print.sampleHash, p.z);
+	}
+
+	return print;
+}
@@ -1,13 +1,18 @@
 #include <meshstructs.h>
 #include <json.hpp>
+#include <memory_resource>
 #pragma once
 
 using JSON = nlohmann::ordered_json;
 
-// GLOBAL EXPORT SETTINGS
-extern bool USE_DEBUG_LOGS;   // toggles debug logs  - (could be preprocessor def but this lets client toggle)
-extern bool INCLUDE_LODS;     // toggles lower level meshes
-extern uint8_t WEIGHT_BITS;
+// GLOBAL EXPORT SETTINGS - load settings are per scene, see StLoadOptions
+extern bool OPTIMIZE_VERTEX_ORDER; // reorders exported triangles/vertices for GPU cache locality
+extern float POSITION_MAX_ERROR;      // max position error of quantized export formats - 0 (default) keeps 32-bit floats
+extern bool INTERLEAVE_VERTEX_STREAMS; // exports all vertex attributes as one strided stream
+extern std::vector<float> LOD_RATIOS; // triangle ratios of generated export LODs - empty exports LOD0 only
+
+#define FINGERPRINT_GRID    0.001f // position quantization step of mesh fingerprints
+#define FINGERPRINT_SAMPLES 64     // vertices hashed per fingerprint
 
 // Known prim JSON keys
 enum enModelData {
@@ -64,9 +69,13 @@ struct StGeoPrim
 class CDataBuffer;
 namespace GeomDef
 {
-	void pushPrimLods(StGeoPrim& prim, std::vector<StGeoPrim>& prim_vec);
+	void pushPrimLods(StGeoPrim&& prim, std::pmr::vector<StGeoPrim>& prim_vec, const bool includeLods);
 	void setMeshVtxs(CDataBuffer* posBf, Mesh& mesh);
 	void calculateVtxNormals(CDataBuffer* tanBf, Mesh& mesh);
 	void addMeshUVMap(CDataBuffer* texBf, Mesh& mesh);
+	size_t removeInvalidTriangles(Mesh& mesh); // returns the number of dropped triangles, reported as warnings
+	void gatherVertices(const Mesh& mesh, const std::vector<uint32_t>& order, Mesh& dst); // dst vertex i = mesh vertex order[i]
+	std::shared_ptr<Mesh> createGroupMesh(const Mesh& mesh, const FaceGroup& group);
+	MeshFingerprint computeFingerprint(const Mesh& mesh); // in game space, whether or not the mesh was aligned for Blender
 };
 
@@ -2,12 +2,15 @@
 #include <scenefile.h>
 #include <common.h>
 #include <armature/bone_reader.h>
+#include <morphs/morphset.h>
 #include <cmath>
 
-CModelReader::CModelReader(const char* id, JSON& data)
+CModelReader::CModelReader(const char* id, JSON& data, const std::shared_ptr<CLoadContext>& context)
 	:
-	CNBAModel(id),
+	CNBAModel(id, context),
 	m_json(data),
+	m_vtxBfs(getArena()),
+	m_dataBfs(getArena()),
 	m_parent(NULL)
 {
 }
@@ -91,38 +94,15 @@ void CModelReader::parse()
 	printf("\n[parse] Parse complete");
 }
 
-inline static void trisFromMeshGroup(std::shared_ptr<Mesh>& fullMesh, std::shared_ptr<Mesh>& splitMsh, const FaceGroup& group)
-{
-	splitMsh->triangles.clear();
-
-	// update index list
-	const int numTris = fullMesh->triangles.size();
-	size_t indexBegin = (group.begin) / 3;
-	size_t indexEnd = (group.begin + group.count) / 3;
-
-	for (size_t i = indexBegin; i < indexEnd; i++)
-		if (i <= numTris)
-		{
-			Triangle& tri = fullMesh->triangles[i];
-			splitMsh->triangles.push_back(tri);
-		}
-};
-
 void CModelReader::splitMeshGroups()
 {
-	if (m_meshes.empty())
+	if (m_meshes.empty() || m_meshes.front()->groups.empty())
 		return;
 
-	// split mesh using groups ...
+	// split mesh using groups - each submesh only holds the vertices its triangles reference
 	auto fullMesh = m_meshes.front();
 	for (auto& group : fullMesh->groups)
-	{
-		auto splitMsh = std::make_shared<Mesh>(*fullMesh);
-		::trisFromMeshGroup(fullMesh, splitMsh, group);
-
-		splitMsh->name = group.name;
-		m_meshes.push_back(splitMsh);
-	}
+		m_meshes.push_back(GeomDef::createGroupMesh(*fullMesh, group));
 
 	m_meshes.erase(m_meshes.begin());
 }
@@ -133,7 +113,7 @@ void CModelReader::loadMeshData()
 		return;
 
 	this->loadMesh();
-	//this->splitMeshGroups();
+	this->splitMeshGroups();
 
 	m_primitives.clear();
 }
@@ -144,6 +124,13 @@ void CModelReader::loadMesh()
 	uintptr_t dataOffset = NULL;
 	int  beginIdx = 0;
 	auto mesh = std::make_shared<Mesh>();
+	auto triBf = findDataBuffer("IndexBuffer");
+
+	// Prims are views into a single contiguous triangle array
+	size_t numIndices = 0;
+	for (auto& prim : m_primitives)
+		numIndices += prim.count;
+	mesh->triangles.reserve(numIndices / 3);
 
 	for (auto& prim : m_primitives)
 	{
@@ -156,12 +143,21 @@ void CModelReader::loadMesh()
 		group.material.setName(prim.material_name.c_str());
 		mesh->groups.push_back(group);
 
-		loadIndices(*mesh, prim.count, dataOffset);
+		loadIndices(*mesh, triBf, prim.count, dataOffset);
 		beginIdx += prim.count;
 	}
 
 	loadVertices(*mesh);
+	GeomDef::removeInvalidTriangles(*mesh);
 	loadWeights(*mesh);
+
+	// Morph rows index the full model vertex buffer
+	if (m_morphs)
+	{
+		m_morphs->setNumVerts(mesh->vertices.size() / mesh->vertexComponents);
+		mesh->morphs = m_morphs;
+	}
+
 	m_meshes.push_back(mesh);
 }
 
@@ -279,7 +275,7 @@ void CModelReader::loadVertices(Mesh& mesh)
 	mesh.texcoord_ref = texBf;
 
 	// System logs
-	if (USE_DEBUG_LOGS) {
+	if (getLoadOptions().debugLogs) {
 		int numVerts = mesh.vertices.size() / mesh.vertexComponents;
 		printf("\n[CModelReader] Built 3D Mesh: \"%s\" | Points: %d | Tris: %d | Components: %d | Split: %s",
 			mesh.name.c_str(),
@@ -293,25 +289,18 @@ void CModelReader::loadVertices(Mesh& mesh)
 	printf("\n[loadVertices] Completed successfully");
 }
 
-void CModelReader::loadIndices(Mesh& mesh, const int count, uintptr_t& offset)
+void CModelReader::loadIndices(Mesh& mesh, const CDataBuffer* triBf, const int count, uintptr_t& offset)
 {
-	auto triBf = findDataBuffer("IndexBuffer");
 	int end = count + offset;
 
-	if (!triBf || end > triBf->data.size() || count % 3 != 0)
+	// Empty prims are valid - there is nothing to widen
+	if (!triBf || count < 3 || end > triBf->getNumValues() || count % 3 != 0)
 		return;
 
-	for (int i = offset; i < end; i += 3)
-	{
-		Triangle face
-		{
-			triBf->data[i],
-			triBf->data[i + 1],
-			triBf->data[i + 2]
-		};
-
-		mesh.triangles.push_back(face);
-	}
+	// Widen indices directly into the mesh triangle array
+	size_t first = mesh.triangles.size();
+	mesh.triangles.resize(first + (count / 3));
+	triBf->copyUInts(offset, count, mesh.triangles[first].data());
 
 	offset += count;
 }
@@ -319,17 +308,18 @@ void CModelReader::loadIndices(Mesh& mesh, const int count, uintptr_t& offset)
 void CModelReader::readVertexFmt(JSON& obj)
 {
 	printf("\n[readVertexFmt] Processing vertex format with %zu entries", obj.size());
+	m_vtxBfs.reserve(m_vtxBfs.size() + obj.size());
 
 	for (JSON::iterator it = obj.begin(); it != obj.end(); ++it)
 	{
 		if (it.value().is_object())
 		{
-			CDataBuffer data;
+			CDataBuffer data(m_context.get(), getArena());
 			data.id = it.key();
 			data.parse(it.value());
-			m_vtxBfs.push_back(data);
+			auto& vtxBf = m_vtxBfs.emplace_back(std::move(data));
 
-			printf("\n[readVertexFmt] Added buffer: %s (stream %d)", data.id.c_str(), data.getStreamIdx());
+			printf("\n[readVertexFmt] Added buffer: %s (stream %d)", vtxBf.id.c_str(), vtxBf.getStreamIdx());
 		}
 	}
 
@@ -358,6 +348,7 @@ CDataBuffer* CModelReader::findDataBuffer(const char* target)
 	{
 		if (dataBf.id == target) {
 			printf("\n[findDataBuffer] Found '%s' in m_dataBfs", target);
+			dataBf.unpack();
 			return &dataBf;
 		}
 	}
@@ -366,6 +357,7 @@ CDataBuffer* CModelReader::findDataBuffer(const char* target)
 	{
 		if (vtxBf.id == target) {
 			printf("\n[findDataBuffer] Found '%s' in m_vtxBfs", target);
+			vtxBf.unpack();
 			return &vtxBf;
 		}
 	}
@@ -394,6 +386,7 @@ void CModelReader::readVertexStream(JSON& obj)
 					printf("\n[readVertexStream] Loading stream %d for buffer %s", index, vtxBf.id.c_str());
 					try {
 						vtxBf.parse(it.value());
+						setVertexKernel(vtxBf);
 						vtxBf.loadBinary();
 						printf("\n[readVertexStream] Stream %d loaded successfully", index);
 					}
@@ -411,25 +404,39 @@ void CModelReader::readVertexStream(JSON& obj)
 	printf("\n[readVertexStream] All streams processed");
 }
 
+void CModelReader::setVertexKernel(CDataBuffer& vtxBf)
+{
+	// Route mesh attributes through the fused decode kernels
+	if (vtxBf.id == "POSITION0")
+		vtxBf.setAttribTfm(BinKernel::positionTfm(vtxBf.getFormat()));
+	else if (vtxBf.id == "TEXCOORD0")
+		vtxBf.setAttribTfm(BinKernel::texcoordTfm());
+	else if (vtxBf.id == "TANGENTFRAME0" || vtxBf.id == "BINORMAL0" || vtxBf.id == "TANGENT0" || vtxBf.id == "NORMAL0")
+		vtxBf.setAttribTfm(BinKernel::tangentFrameTfm());
+
+	// Everything else stays packed until it is looked up
+	vtxBf.setDeferDecode(vtxBf.getAttribTfm().kernel == enAttribKernel::NONE);
+}
+
 void CModelReader::readMtxWeightBuffer(JSON& obj)
 {
 	// find weight data stream
-	CDataBuffer data;
+	CDataBuffer data(m_context.get(), getArena());
 	data.parse(obj);
 	data.loadBinary();
 	data.id = "MatrixWeightBuffer";
 
-	m_dataBfs.push_back(data);
+	m_dataBfs.push_back(std::move(data));
 };
 
 void CModelReader::readIndexBuffer(JSON& obj)
 {
-	CDataBuffer data;
+	CDataBuffer data(m_context.get(), getArena());
 	data.parse(obj);
 	data.loadBinary();
 	data.id = "IndexBuffer";
 
-	m_dataBfs.push_back(data);
+	m_dataBfs.push_back(std::move(data));
 }
 
 void CModelReader::readPrim(JSON& obj)
@@ -445,7 +452,7 @@ void CModelReader::readPrim(JSON& obj)
 			grp.uv_deriv = (grp.uv_deriv.empty()) ? g_uvDeriv : grp.uv_deriv;
 
 			// push lods
-			GeomDef::pushPrimLods(grp, m_primitives);
+			GeomDef::pushPrimLods(std::move(grp), m_primitives, getLoadOptions().includeLods);
 		}
 	}
 }
@@ -460,38 +467,33 @@ inline static float unpackWeight(uint16_t packedWeight) {
 	return static_cast<float>(packedWeight) / 65535.0f;
 }
 
-inline static void loadPackedWeights(const uint32_t& index, const std::vector<float>& mtxData, const int num_weights, BlendVertex& skinVtx)
+inline static void loadPackedWeights(const uint32_t& index, const CDataBuffer* matrixBf, const int num_weights, Skin& skin)
 {
 	uint32_t encodedValue, blendIdx, skinVal;
-	skinVtx.weights.resize(num_weights);
-	skinVtx.indices.resize(num_weights);
+	size_t numValues = matrixBf->getNumValues();
 
 	// ✓ Add bounds check
-	if (index >= mtxData.size()) {
-		printf("\n[loadPackedWeights] ERROR: index %d out of range (size: %zu)", index, mtxData.size());
+	if (index >= numValues) {
+		printf("\n[loadPackedWeights] ERROR: index %d out of range (size: %zu)", index, numValues);
 		// Fill with default weights
-		for (int i = 0; i < num_weights; i++) {
-			skinVtx.indices[i] = 0;
-			skinVtx.weights[i] = 0.0f;
-		}
+		for (int i = 0; i < num_weights; i++)
+			skin.pushInfluence(0, 0.0f);
 		return;
 	}
 
 	for (int i = 0; i < num_weights; i++)
 	{
 		// ✓ Check each access
-		if (index + i >= mtxData.size()) {
-			printf("\n[loadPackedWeights] ERROR: index+i (%d) out of range (size: %zu)", index + i, mtxData.size());
-			skinVtx.indices[i] = 0;
-			skinVtx.weights[i] = 0.0f;
+		if (index + i >= numValues) {
+			printf("\n[loadPackedWeights] ERROR: index+i (%d) out of range (size: %zu)", index + i, numValues);
+			skin.pushInfluence(0, 0.0f);
 			continue;
 		}
 
-		encodedValue = mtxData[index + i];
+		encodedValue = matrixBf->getUInt(index + i);
 		blendIdx = encodedValue >> 0x10;
 		skinVal = encodedValue & 0xFFFF;
-		skinVtx.indices[i] = blendIdx;
-		skinVtx.weights[i] = ::unpackWeight(skinVal);
+		skin.pushInfluence(static_cast<uint16_t>(blendIdx), ::unpackWeight(skinVal));
 	}
 }
 
@@ -499,25 +501,26 @@ inline static void loadMatrixBufferWeights(
 	Mesh& mesh, const size_t& numVerts, const size_t& numElems, const CDataBuffer* weightBf, const CDataBuffer* matrixBf)
 {
 	printf("\n[loadMatrixBufferWeights] numVerts: %zu, matrixBf size: %zu, weightBf size: %zu",
-		numVerts, matrixBf->data.size(), weightBf->data.size());
+		numVerts, matrixBf->getNumValues(), weightBf->getNumValues());
 
 	uint32_t packedVtxSkin, numWeights, index;
-	mesh.skin.blendverts.resize(numVerts);
+	auto& skin = mesh.skin;
+	skin.clear();
+	skin.reserve(numVerts, numElems + numVerts);
 
 	for (size_t i = 0; i < numVerts; i++)
 	{
-		auto& skinVtx = mesh.skin.blendverts[i];
-		packedVtxSkin = weightBf->data[i];
+		packedVtxSkin = weightBf->getUInt(i);
 		numWeights = packedVtxSkin & 0xFF;
 		index = packedVtxSkin >> 0x8;
 
 		if (numWeights == 0) {
-			skinVtx.weights.push_back(1.0f);
-			skinVtx.indices.push_back(index);
+			skin.pushInfluence(static_cast<uint16_t>(index), 1.0f);
 		}
 		else {
-			::loadPackedWeights(index, matrixBf->data, numWeights + 1, skinVtx);
+			::loadPackedWeights(index, matrixBf, numWeights + 1, skin);
 		}
+		skin.endVertex();
 	}
 
 	printf("\n[loadMatrixBufferWeights] Completed successfully");
@@ -532,37 +535,28 @@ void CModelReader::loadWeights(Mesh& mesh)
 		return;
 
 	// Get num total elements
-	size_t numBfElems = matrixBf->data.size();
+	size_t numBfElems = matrixBf->getNumValues();
 	size_t numVerts = mesh.vertices.size() / 3;
-	if (numVerts > weightBf->data.size())
+	if (numVerts > weightBf->getNumValues())
 		return;
 
 	// Load vertex skin
 	::loadMatrixBufferWeights(mesh, numVerts, numBfElems, weightBf, matrixBf);
 
-	// ✓ Skip updateIndices for now - causes crashes on some meshes
-	printf("\n[loadWeights] Skipping updateIndices (known issue with static jerseys)");
-	// mesh.skin.updateIndices(&m_skeleton);
+	// Joint names are resolved once per skeleton joint - no per-influence lookups left to overrun
+	mesh.skin.updateIndices(&m_skeleton);
 }
 
 void CModelReader::readMorphs(JSON& obj)
 {
-	// debug morph id's - collects and prints all debug morphs
-	return;
+	// Targets are only registered here - delta streams are read when a target is first used
+	m_morphs = std::make_shared<CMorphSet>(m_context);
 
-	std::vector<std::string> debugMorphs;
 	for (JSON::iterator it = obj.begin(); it != obj.end(); ++it)
-	{
-		debugMorphs.push_back(it.key());
-	}
-
-	printf("\ndebugMorphs = {");
-	for (auto& morph : debugMorphs)
-	{
-		printf("\n\"%s\",", morph.c_str());
-	}
+		m_morphs->addTarget(it.key(), it.value());
 
-	printf("};");
+	if (getLoadOptions().debugLogs)
+		printf("\n[CModelReader] Registered %zu morph targets", m_morphs->size());
 }
 
 // ========================================
@@ -571,27 +565,27 @@ void CModelReader::readMorphs(JSON& obj)
 
 void CModelReader::readNormalIndexBuffer(JSON& obj)
 {
-	CDataBuffer data;
+	CDataBuffer data(m_context.get(), getArena());
 	data.parse(obj);
 	data.loadBinary();
 	data.id = "NormalIndexBuffer";
-	m_dataBfs.push_back(data);
+	auto& idxBf = m_dataBfs.emplace_back(std::move(data));
 
-	if (USE_DEBUG_LOGS) {
-		printf("\n[CModelReader] Loaded NormalIndexBuffer: %zu indices", data.data.size());
+	if (getLoadOptions().debugLogs) {
+		printf("\n[CModelReader] Loaded NormalIndexBuffer: %zu indices", idxBf.getNumValues());
 	}
 }
 
 void CModelReader::readTangentIndexBuffer(JSON& obj)
 {
-	CDataBuffer data;
+	CDataBuffer data(m_context.get(), getArena());
 	data.parse(obj);
 	data.loadBinary();
 	data.id = "TangentIndexBuffer";
-	m_dataBfs.push_back(data);
+	auto& idxBf = m_dataBfs.emplace_back(std::move(data));
 
-	if (USE_DEBUG_LOGS) {
-		printf("\n[CModelReader] Loaded TangentIndexBuffer: %zu indices", data.data.size());
+	if (getLoadOptions().debugLogs) {
+		printf("\n[CModelReader] Loaded TangentIndexBuffer: %zu indices", idxBf.getNumValues());
 	}
 }
 
@@ -608,37 +602,25 @@ void CModelReader::expandSplitAttributes(Mesh& mesh)
 
 	printf("\n[expandSplitAttributes] Processing split index format");
 	printf("\n  - Unique tangent frames: %zu", tanBf->data.size() / 3);
-	printf("\n  - Normal indices: %zu (per-vertex)", normalIdxBf->data.size());
+	printf("\n  - Normal indices: %zu (per-vertex)", normalIdxBf->getNumValues());
 	printf("\n  - Vertices: %zu", mesh.vertices.size() / mesh.vertexComponents);
 
 	mesh.uniqueTangents = tanBf->data;
 
-	// ✓ Use the ORIGINAL function that worked!
-	Mesh tempMesh;
-	size_t numUniqueTangents = tanBf->data.size() / 3;
-
-	tempMesh.vertices.resize(numUniqueTangents * 3);
-	for (size_t i = 0; i < numUniqueTangents; i++) {
-		tempMesh.vertices[i * 3 + 0] = 0.0f;
-		tempMesh.vertices[i * 3 + 1] = 0.0f;
-		tempMesh.vertices[i * 3 + 2] = 0.0f;
-	}
-
-	// Use original function instead of octahedral
-	GeomDef::calculateVtxNormals(tanBf, tempMesh);
-	mesh.uniqueNormals = tempMesh.normals;
+	// Unique normals come straight from the tangent frame kernel
+	mesh.uniqueNormals = tanBf->frameNormals;
 
 	printf("\n[expandSplitAttributes] Decoded %zu unique normals", mesh.uniqueNormals.size() / 3);
 
 	// Store indices
 	mesh.normalIndices.clear();
-	for (size_t i = 0; i < normalIdxBf->data.size(); i++) {
-		mesh.normalIndices.push_back(static_cast<uint16_t>(normalIdxBf->data[i]));
+	for (size_t i = 0; i < normalIdxBf->getNumValues(); i++) {
+		mesh.normalIndices.push_back(static_cast<uint16_t>(normalIdxBf->getUInt(i)));
 	}
 
 	mesh.tangentIndices.clear();
-	for (size_t i = 0; i < tangentIdxBf->data.size(); i++) {
-		mesh.tangentIndices.push_back(static_cast<uint16_t>(tangentIdxBf->data[i]));
+	for (size_t i = 0; i < tangentIdxBf->getNumValues(); i++) {
+		mesh.tangentIndices.push_back(static_cast<uint16_t>(tangentIdxBf->getUInt(i)));
 	}
 
 	// Assign per-vertex normals
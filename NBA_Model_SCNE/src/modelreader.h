@@ -7,12 +7,13 @@
 #pragma once
 
 class CSceneFile;
+class CMorphSet;
 using JSON = nlohmann::ordered_json;
 
 class CModelReader : public CNBAModel
 {
 public:
-	CModelReader(const char* id, JSON& data);
+	CModelReader(const char* id, JSON& data, const std::shared_ptr<CLoadContext>& context);
 	~CModelReader();
 
 	void parse();
@@ -24,13 +25,14 @@ private:
 	void loadMeshData();
 	void loadWeights(Mesh& mesh);
 	void loadVertices(Mesh& mesh);
-	void loadIndices(Mesh& mesh, const int count, uintptr_t& offset);
+	void loadIndices(Mesh& mesh, const CDataBuffer* triBf, const int count, uintptr_t& offset);
 	void loadMesh();
 	void readMorphs(JSON& obj);
 	void readTfms(JSON& obj);
 	void readPrim(JSON& obj);
 	void readVertexFmt(JSON& obj);
 	void readVertexStream(JSON& obj);
+	void setVertexKernel(CDataBuffer& vtxBf);
 	void readIndexBuffer(JSON& obj);
 	void readMtxWeightBuffer(JSON& obj);
 	void decodeOctahedralNormals(CDataBuffer* tanBf, Mesh& mesh);
@@ -46,8 +48,9 @@ private:
 
 private:
 	JSON m_json;
-	std::vector<CDataBuffer> m_vtxBfs;
-	std::vector<CDataBuffer> m_dataBfs;
+	std::shared_ptr<CMorphSet> m_morphs;
+	std::pmr::vector<CDataBuffer> m_vtxBfs;
+	std::pmr::vector<CDataBuffer> m_dataBfs;
 	CSceneFile* m_parent;
 };
 
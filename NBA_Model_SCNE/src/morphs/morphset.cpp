@@ -0,0 +1,352 @@
+#include <morphs/morphset.h>
+#include <meshstructs.h>
+#include <bin_codec.h>
+#include <threadpool.h>
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+
+CMorphSet::CMorphSet(const std::shared_ptr<CLoadContext>& context)
+	:
+	m_context(context),
+	m_numVerts(0)
+{
+}
+
+void CMorphSet::addTarget(const std::string& name, const JSON& source)
+{
+	if (m_targetIndex.count(name))
+		return;
+
+	m_targetIndex.emplace(name, static_cast<int>(m_targets.size()));
+	m_targets.push_back(StMorphTarget{ name, source, {}, {}, { 1.0f, 1.0f, 1.0f }, { 0.0f, 0.0f, 0.0f }, false });
+}
+
+int CMorphSet::findTarget(const std::string& name) const
+{
+	auto it = m_targetIndex.find(name);
+	return (it != m_targetIndex.end()) ? it->second : -1;
+}
+
+const StMorphTarget& CMorphSet::getTarget(const int target)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	auto& morph = m_targets[target];
+
+	if (!morph.decoded)
+		this->decode(morph);
+
+	return morph;
+}
+
+size_t CMorphSet::getDecodedBytes() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	size_t bytes = 0;
+	for (auto& morph : m_targets)
+		bytes += morph.indices.size() * sizeof(uint32_t) + morph.deltas.size() * sizeof(int16_t);
+	return bytes;
+}
+
+void StMorphTarget::getDelta(const size_t row, float* delta) const
+{
+	const int16_t* d = &deltas[row * 4];
+	for (int c = 0; c < 3; c++)
+		delta[c] = d[c] * scale[c] + offset[c];
+}
+
+// Dense delta stream - one row per model vertex
+struct StDeltaLayout
+{
+	size_t offset   = 0;
+	size_t stride   = 0;
+	size_t elemSize = 0;
+	int bits        = 0;     // 8 or 16 for integer channels kept as stored, 0 when decoded to float
+	bool isSigned   = false;
+	float norm      = 1.0f;  // snorm/unorm divisor
+};
+
+static bool getDenseLayout(const JSON& source, CDataBuffer& buffer, const size_t binarySize, const size_t numVerts, StDeltaLayout& layout)
+{
+	for (auto key : { "Format", "Binary", "Size", "Stride" })
+		if (!source.contains(key))
+			return false;
+
+	if (!source["Size"].is_number_integer() || !source["Stride"].is_number_integer())
+		return false;
+
+	size_t channels = 0;
+	try
+	{
+		BinaryCodec codec(buffer.getEncoding(), buffer.getType());
+		channels = codec.num_channels();
+		layout.elemSize = codec.size(1);
+	}
+	catch (...) {
+		return false;
+	}
+
+	size_t size = source["Size"];
+	layout.offset = buffer.getDataOffset();
+	layout.stride = buffer.getStride();
+
+	if (channels < 3 || !numVerts || layout.stride < layout.elemSize || size % layout.stride || size / layout.stride != numVerts)
+		return false;
+
+	if (layout.offset + ((numVerts - 1) * layout.stride) + layout.elemSize > binarySize)
+		return false;
+
+	// 8/16-bit integer channels are read as stored, everything else through the codec (8-bit strides)
+	const std::string& type = buffer.getType();
+	int bits = static_cast<int>(layout.elemSize * 8 / channels);
+	bool isInteger = (type == "snorm" || type == "unorm" || type == "sint" || type == "uint");
+
+	if (isInteger && (bits == 8 || bits == 16) && layout.elemSize * 8 == bits * channels)
+	{
+		layout.bits = bits;
+		layout.isSigned = (type == "snorm" || type == "sint");
+		layout.norm = (type == "snorm") ? float((1 << (bits - 1)) - 1) : (type == "unorm") ? float((1 << bits) - 1) : 1.0f;
+		return true;
+	}
+
+	return (layout.stride <= UINT8_MAX);
+}
+
+template <typename T>
+static void readChannels(const uint8_t* row, int32_t* values)
+{
+	T packed[3];
+	memcpy(packed, row, sizeof(packed));
+	for (int c = 0; c < 3; c++)
+		values[c] = packed[c];
+}
+
+void CMorphSet::decode(StMorphTarget& morph)
+{
+	morph.decoded = true;
+
+	// Entries without a stream (name only) stay empty
+	if (!morph.source.is_object() || !morph.source.contains("Binary"))
+		return;
+
+	CDataBuffer deltaBf(m_context.get());
+	std::vector<uint8_t> binary;
+	StDeltaLayout layout;
+
+	try
+	{
+		deltaBf.parse(morph.source);
+		binary = deltaBf.getBinary();
+	}
+	catch (const std::exception& e) {
+		printf("\n[CMorphSet] WARNING: %s", e.what());
+		return;
+	}
+
+	if (!::getDenseLayout(morph.source, deltaBf, binary.size(), m_numVerts, layout)) {
+		printf("\n[CMorphSet] WARNING: '%s' is not a dense delta stream of %zu vertices - target skipped",
+			morph.name.c_str(), m_numVerts);
+		morph.source = nullptr;
+		return;
+	}
+
+	// Stream transform - only applied when both are defined, same as StAttribTfm::setScaleOffset
+	float tfmScale[3] = { 1.0f, 1.0f, 1.0f };
+	float tfmOffset[3] = { 0.0f, 0.0f, 0.0f };
+	if (deltaBf.scale.size() >= 3 && deltaBf.translate.size() >= 3)
+		for (int c = 0; c < 3; c++)
+		{
+			tfmScale[c] = deltaBf.scale[c];
+			tfmOffset[c] = deltaBf.translate[c];
+		}
+
+	std::vector<int32_t> values(m_numVerts * 3);
+	if (layout.bits)
+	{
+		// Integer streams keep their stored values - 16-bit unsigned ones are biased into int16
+		int32_t bias = (layout.bits == 16 && !layout.isSigned) ? 32768 : 0;
+		for (int c = 0; c < 3; c++)
+		{
+			morph.scale[c] = tfmScale[c] / layout.norm;
+			morph.offset[c] = tfmOffset[c] + (bias * morph.scale[c]);
+		}
+
+		const uint8_t* row = binary.data() + layout.offset;
+		for (size_t i = 0; i < m_numVerts; i++, row += layout.stride)
+		{
+			int32_t* dst = &values[i * 3];
+			if (layout.bits == 16 && layout.isSigned)
+				::readChannels<int16_t>(row, dst);
+			else if (layout.bits == 16)
+				::readChannels<uint16_t>(row, dst);
+			else if (layout.isSigned)
+				::readChannels<int8_t>(row, dst);
+			else
+				::readChannels<uint8_t>(row, dst);
+
+			for (int c = 0; c < 3; c++)
+				dst[c] -= bias;
+		}
+	}
+	else
+	{
+		// Float streams are quantized once, against the largest component of the target
+		std::vector<float> decoded;
+		char* src = reinterpret_cast<char*>(binary.data());
+		BinaryCodec codec(deltaBf.getEncoding(), deltaBf.getType());
+		codec.decode(src, static_cast<int>(m_numVerts), decoded, layout.offset, static_cast<uint8_t>(layout.stride));
+
+		size_t channels = decoded.size() / m_numVerts;
+		float maxDelta = 0.0f;
+		for (size_t i = 0; i < m_numVerts; i++)
+			for (int c = 0; c < 3; c++)
+			{
+				float& d = decoded[i * channels + c];
+				d = d * tfmScale[c] + tfmOffset[c];
+				maxDelta = std::max(maxDelta, std::abs(d));
+			}
+
+		float step = (maxDelta > 0.0f) ? maxDelta / 32767.0f : 1.0f;
+		for (int c = 0; c < 3; c++)
+		{
+			morph.scale[c] = step;
+			morph.offset[c] = 0.0f;
+		}
+
+		for (size_t i = 0; i < m_numVerts; i++)
+			for (int c = 0; c < 3; c++)
+				values[i * 3 + c] = static_cast<int32_t>(std::lround(decoded[i * channels + c] / step));
+	}
+
+	// Keep the rows that move their vertex
+	for (size_t i = 0; i < m_numVerts; i++)
+	{
+		const int32_t* q = &values[i * 3];
+		float rowMax = 0.0f;
+		for (int c = 0; c < 3; c++)
+			rowMax = std::max(rowMax, std::abs(q[c] * morph.scale[c] + morph.offset[c]));
+
+		if (rowMax <= MORPH_DELTA_EPSILON)
+			continue;
+
+		morph.indices.push_back(static_cast<uint32_t>(i));
+		morph.deltas.insert(morph.deltas.end(), { int16_t(q[0]), int16_t(q[1]), int16_t(q[2]), 0 });
+	}
+
+	morph.source = nullptr;
+}
+
+std::vector<uint32_t> CMorphSet::getViewMap(const std::vector<uint32_t>& sourceVertices) const
+{
+	std::vector<uint32_t> viewMap;
+	if (sourceVertices.empty())
+		return viewMap;
+
+	viewMap.assign(m_numVerts, NO_VERTEX);
+	for (size_t i = 0; i < sourceVertices.size(); i++)
+		if (sourceVertices[i] < m_numVerts)
+			viewMap[sourceVertices[i]] = static_cast<uint32_t>(i);
+
+	return viewMap;
+}
+
+// Writes base + sum for one chunk - the axis swap and the view lookup are resolved per call, not per vertex
+template <bool BlenderSpace, bool HasView>
+static void writeMorphed(const float* base, const int baseStride, const float* sum, const uint32_t* viewMap,
+	const size_t begin, const size_t end, float* out)
+{
+	for (size_t v = begin; v < end; v++, sum += 4)
+	{
+		size_t view = v;
+		if constexpr (HasView)
+		{
+			view = viewMap[v];
+			if (view == CMorphSet::NO_VERTEX)
+				continue;
+		}
+
+		const float* src = &base[view * baseStride];
+		float* dst = &out[view * 3];
+
+		if constexpr (BlenderSpace)
+		{
+			dst[0] = src[0] + sum[0];
+			dst[1] = src[1] - sum[2];
+			dst[2] = src[2] + sum[1];
+		}
+		else
+		{
+			dst[0] = src[0] + sum[0];
+			dst[1] = src[1] + sum[1];
+			dst[2] = src[2] + sum[2];
+		}
+	}
+}
+
+void CMorphSet::evaluate(const float* base, const int baseStride, const float* weights, const size_t numWeights,
+	float* out, const bool blenderSpace, const std::vector<uint32_t>& viewMap)
+{
+	// Weighted scale and offset lanes per target - the w lane stays zero
+	struct StActiveTarget
+	{
+		const StMorphTarget* morph;
+		float scale[4];
+		float offset[4];
+	};
+
+	// Decode active targets up front so the workers only read
+	std::vector<StActiveTarget> active;
+	for (size_t i = 0; i < std::min(numWeights, m_targets.size()); i++)
+	{
+		if (weights[i] == 0.0f)
+			continue;
+
+		auto& morph = this->getTarget(static_cast<int>(i));
+		if (morph.indices.empty())
+			continue;
+
+		StActiveTarget target{ &morph, { 0.0f, 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f, 0.0f } };
+		for (int c = 0; c < 3; c++)
+		{
+			target.scale[c] = weights[i] * morph.scale[c];
+			target.offset[c] = weights[i] * morph.offset[c];
+		}
+		active.push_back(target);
+	}
+
+	bool hasView = !viewMap.empty();
+	auto& pool = (m_context) ? m_context->getThreadPool() : CThreadPool::instance();
+	pool.parallelFor(m_numVerts, MORPH_EVAL_CHUNK, MORPH_EVAL_CHUNK, [&](size_t begin, size_t end)
+	{
+		std::vector<float> sum((end - begin) * 4, 0.0f);
+
+		for (auto& [morph, scale, offset] : active)
+		{
+			auto first = std::lower_bound(morph->indices.begin(), morph->indices.end(), uint32_t(begin));
+			auto last = std::lower_bound(first, morph->indices.end(), uint32_t(end));
+
+			// Rows are scattered by vertex index - each one is a single 4-lane multiply-add
+			for (auto it = first; it != last; ++it)
+			{
+				size_t k = it - morph->indices.begin();
+				const int16_t* delta = &morph->deltas[k * 4];
+				float* dst = &sum[(*it - begin) * 4];
+
+				for (int c = 0; c < 4; c++)
+					dst[c] += scale[c] * float(delta[c]) + offset[c];
+			}
+		}
+
+		// Rows are summed in source order - group views write each source vertex to its view slot
+		const uint32_t* view = viewMap.data();
+		if (blenderSpace && hasView)
+			::writeMorphed<true, true>(base, baseStride, sum.data(), view, begin, end, out);
+		else if (blenderSpace)
+			::writeMorphed<true, false>(base, baseStride, sum.data(), view, begin, end, out);
+		else if (hasView)
+			::writeMorphed<false, true>(base, baseStride, sum.data(), view, begin, end, out);
+		else
+			::writeMorphed<false, false>(base, baseStride, sum.data(), view, begin, end, out);
+	});
+}
@@ -0,0 +1,63 @@
+/* Sparse morph targets - each target keeps only the vertices it moves, as 16-bit quantized deltas decoded on first use.
+   Only dense streams (one row per model vertex, xyz in the first channels) are decoded - other layouts stay name only */
+
+#include <databuffer.h>
+#include <loadcontext.h>
+#include <unordered_map>
+#include <mutex>
+#pragma once
+
+#define MORPH_DELTA_EPSILON 1e-6f // rows whose largest delta component is at or below this are dropped
+#define MORPH_EVAL_CHUNK    4096  // vertices per evaluation task
+
+struct StMorphTarget
+{
+	std::string name;
+	JSON source;                    // delta stream description, binary is read on decode
+	std::vector<uint32_t> indices;  // touched vertices, ascending
+	std::vector<int16_t> deltas;    // x, y, z, 0 per touched vertex - padded to one 4-wide lane
+	float scale[3];                 // delta = deltas * scale + offset per channel, game space
+	float offset[3];                // 8/16-bit integer streams keep their stored values, float streams are quantized once
+	bool decoded;
+
+	void getDelta(const size_t row, float* delta) const; // xyz of row, game space
+};
+
+class CMorphSet
+{
+public:
+	CMorphSet(const std::shared_ptr<CLoadContext>& context);
+
+public:
+	void addTarget(const std::string& name, const JSON& source);
+	void setNumVerts(const size_t numVerts) { m_numVerts = numVerts; }
+
+	size_t size() const { return m_targets.size(); }
+	size_t getNumVerts() const { return m_numVerts; }
+	int findTarget(const std::string& name) const;
+	const std::string& getName(const int target) const { return m_targets[target].name; }
+
+	// Decodes the target on first access
+	const StMorphTarget& getTarget(const int target);
+
+	// Group views (Mesh::sourceVertices) see the rows of their own vertices - returns source vertex -> view vertex or NO_VERTEX
+	static constexpr uint32_t NO_VERTEX = UINT32_MAX;
+	std::vector<uint32_t> getViewMap(const std::vector<uint32_t>& sourceVertices) const;
+
+	// out = base + sum(weights[i] * target i), one xyz per base vertex. 'blenderSpace' when base was aligned to (x, -z, y).
+	// 'viewMap' from getViewMap when base is a group view, empty when it is the full vertex buffer
+	void evaluate(const float* base, const int baseStride, const float* weights, const size_t numWeights,
+		float* out, const bool blenderSpace, const std::vector<uint32_t>& viewMap = {});
+
+	size_t getDecodedBytes() const;
+
+private:
+	void decode(StMorphTarget& target);
+
+private:
+	std::vector<StMorphTarget> m_targets;
+	std::unordered_map<std::string, int> m_targetIndex;
+	std::shared_ptr<CLoadContext> m_context; // binaries are decoded after the load finished
+	size_t m_numVerts;
+	mutable std::mutex m_mutex; // guards decoding and the decoded rows
+};
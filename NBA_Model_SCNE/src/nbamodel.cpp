@@ -1,8 +1,11 @@
 #include <nbamodel.h>
+#include <common.h>
 
-CNBAModel::CNBAModel(const char* id)
+CNBAModel::CNBAModel(const char* id, const std::shared_ptr<CLoadContext>& context)
 	:
 	m_name(id),
+	m_context(context),
+	m_primitives(getArena()),
 	m_weightBits(16),
 	m_worldPosition({ 0.0f, 0.0f, 0.0f }),
 	m_boundingMin({ 0.0f, 0.0f, 0.0f }),
@@ -16,6 +19,17 @@ CNBAModel::~CNBAModel()
 	m_meshes.clear();
 }
 
+std::pmr::memory_resource* CNBAModel::getArena() const
+{
+	return (m_context) ? m_context->getArena() : std::pmr::get_default_resource();
+}
+
+const StLoadOptions& CNBAModel::getLoadOptions() const
+{
+	static const StLoadOptions defaults;
+	return (m_context) ? m_context->getOptions() : defaults;
+}
+
 int CNBAModel::getNumMeshes()
 {
 	return m_meshes.size();
@@ -40,7 +54,7 @@ std::string CNBAModel::name()
 
 bool CNBAModel::hasSkeleton()
 {
-	return !m_skeleton.joints.empty();
+	return !m_skeleton.empty();
 }
 
 void CNBAModel::pushMesh(const Mesh& mesh)
@@ -2,11 +2,12 @@
 #include <meshprimitive.h>
 #include <armature/armature.h>
 #include <databuffer.h>
+#include <loadcontext.h>
 
 class CNBAModel
 {
 public:
-	CNBAModel(const char* id);
+	CNBAModel(const char* id, const std::shared_ptr<CLoadContext>& context = nullptr);
 	~CNBAModel();
 
 public:
@@ -72,11 +73,16 @@ public:
 	 */
 	void setVertexComponents(int meshIndex, int components);
 
+protected:
+	std::pmr::memory_resource* getArena() const;
+	const StLoadOptions& getLoadOptions() const;
+
 protected:
 	std::string m_name;
 	NSSkeleton m_skeleton;
 	std::vector<std::shared_ptr<Mesh>> m_meshes;
-	std::vector<StGeoPrim> m_primitives;
+	std::shared_ptr<CLoadContext> m_context; // null for models built in Blender - keeps the load arena alive
+	std::pmr::vector<StGeoPrim> m_primitives; // load-time only, lives in the load arena
 	std::vector<Array2D> g_uvDeriv;
 	int m_weightBits;
 
@@ -40,4 +40,35 @@ void CNBAScene::pushModel(const CNBAModel& model)
 {
 	auto newModel = std::make_shared<CNBAModel>(model);
 	m_models.push_back(newModel);
-}
\ No newline at end of file
+}
+
+void CNBAScene::buildMeshIndex()
+{
+	m_meshByFingerprint.clear();
+	m_meshByName.clear();
+
+	for (auto& model : m_models)
+		for (auto& mesh : model->getMeshes())
+		{
+			if (mesh->fingerprint.empty())
+				mesh->fingerprint = GeomDef::computeFingerprint(*mesh);
+
+			// First mesh wins - exact duplicates can only be told apart by name
+			if (!m_meshByFingerprint.emplace(mesh->fingerprint.key(), mesh).second)
+				printf("\n[CNBAScene] WARNING: '%s' has the same fingerprint as another mesh", mesh->name.c_str());
+
+			m_meshByName.emplace(mesh->name, mesh);
+		}
+}
+
+std::shared_ptr<Mesh> CNBAScene::findMesh(const uint64_t fingerprint)
+{
+	auto it = m_meshByFingerprint.find(fingerprint);
+	return (it != m_meshByFingerprint.end()) ? it->second : nullptr;
+}
+
+std::shared_ptr<Mesh> CNBAScene::findMesh(const std::string& id)
+{
+	auto it = m_meshByName.find(id);
+	return (it != m_meshByName.end()) ? it->second : nullptr;
+}
@@ -3,9 +3,11 @@
 #include <vector>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #pragma once
 
 struct Material;
+struct Mesh;
 class CNBAModel;
 
 class CNBAScene
@@ -26,10 +28,18 @@ public:
 public:
 	void pushModel(const CNBAModel& model);
 
+public:
+	// Fingerprint and name lookups of every mesh - rebuilt after the scene is parsed
+	void buildMeshIndex();
+	std::shared_ptr<Mesh> findMesh(const uint64_t fingerprint);
+	std::shared_ptr<Mesh> findMesh(const std::string& id);
+
 protected:
 	std::string m_name;
 	std::vector<std::shared_ptr<CNBAModel>> m_models;
 	std::vector<Material> m_materials;
+	std::unordered_map<uint64_t, std::shared_ptr<Mesh>> m_meshByFingerprint;
+	std::unordered_map<std::string, std::shared_ptr<Mesh>> m_meshByName;
 };
 
 
@@ -5,9 +5,10 @@
 
 #include <sstream>
 
-CSceneFile::CSceneFile(const char* path)
+CSceneFile::CSceneFile(const char* path, const StLoadOptions& options)
 	: 
-	m_path(path)
+	m_path(path),
+	m_context(std::make_shared<CLoadContext>(common::get_parent_directory(path), options))
 {
 }
 
@@ -18,10 +19,18 @@ CSceneFile::~CSceneFile()
 void
 CSceneFile::load()
 {
+	m_context->setStage(LOAD_READ_JSON);
 	if (!validate())
 		throw std::runtime_error("Cannot read scene file.");
 
+	// Binaries are looked up by name - walk the folder once before the first model
+	m_context->checkCancelled();
+	m_context->setStage(LOAD_SCAN_FILES);
+	m_context->scanFiles();
+
 	/* load skin model object */
+	m_context->checkCancelled();
+	m_context->setStage(LOAD_MODELS);
 	CSceneFile::parse();
 }
 
@@ -36,9 +45,6 @@ CSceneFile::parse()
 {
 	printf("\n\n[CSceneFile] Loading Scene File: %s\n", m_path.c_str());
 	
-	/* Update global active file */
-	WORKING_DIR = common::get_parent_directory(m_path);
-
 	/* Iterate through scene json structure */
 	for (JSON::iterator it = m_json.begin(); it != m_json.end(); ++it)
 	{
@@ -46,7 +52,7 @@ CSceneFile::parse()
 		{
 			std::string scene_id = it.key();
 
-			auto scene = std::make_shared<CSceneReader>(scene_id.c_str(), it.value());
+			auto scene = std::make_shared<CSceneReader>(scene_id.c_str(), it.value(), m_context);
 			scene->parse();
 			this->m_scene = scene;
 		}
@@ -59,6 +65,7 @@ CSceneFile::validate()
 	try 
 	{
 		auto data = formatInputJson(m_path);
+		m_context->addBytesRead(data.size());
 		m_json = JSON::parse(data.c_str());
 	}
 	catch (...) {return false;}
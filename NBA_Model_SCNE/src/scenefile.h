@@ -2,6 +2,7 @@
 
 #include <fstream>
 #include <json.hpp>
+#include <loadcontext.h>
 #pragma once
 
 using JSON = nlohmann::ordered_json;
@@ -10,12 +11,13 @@ class CNBAScene;
 class CSceneFile
 {
 public:
-	CSceneFile(const char* path);
+	CSceneFile(const char* path, const StLoadOptions& options = StLoadOptions());
 	~CSceneFile();
 
 public:
 	virtual void load();
 	std::shared_ptr<CNBAScene>& scene();
+	const std::shared_ptr<CLoadContext>& context() const { return m_context; }
 
 protected:
 	void parse();
@@ -25,6 +27,7 @@ protected:
 protected:
 	JSON m_json;
 	std::string m_path;
+	std::shared_ptr<CLoadContext> m_context; // shared with every model read from this file
 	std::shared_ptr<CNBAScene> m_scene;
 };
 
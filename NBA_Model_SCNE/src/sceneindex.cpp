@@ -0,0 +1,105 @@
+#include <sceneindex.h>
+#include <scenefile.h>
+#include <nbascene.h>
+#include <nbamodel.h>
+#include <common.h>
+
+CSceneIndex& CSceneIndex::instance()
+{
+	static CSceneIndex index;
+	return index;
+}
+
+std::optional<StSceneMeshRef> CSceneIndex::find(const std::string& folder, const uint64_t fingerprint, const std::string& id)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	auto& index = m_folders[folder];
+	this->refresh(folder, index);
+
+	auto findPrint = [&](const std::string& path, const StFileEntry& entry) -> std::optional<StSceneMeshRef> {
+		for (auto& [print, name] : entry.meshes)
+			if (print == fingerprint)
+				return StSceneMeshRef{ path, name };
+		return std::nullopt;
+	};
+
+	// Cached files first, then load the rest until the fingerprint turns up
+	if (fingerprint)
+	{
+		for (auto& [path, entry] : index)
+			if (entry.indexed)
+				if (auto ref = findPrint(path, entry))
+					return ref;
+
+		for (auto& [path, entry] : index)
+			if (!entry.indexed) {
+				this->indexFile(path, entry);
+				if (auto ref = findPrint(path, entry))
+					return ref;
+			}
+	}
+
+	for (auto& [path, entry] : index)
+	{
+		if (!entry.indexed)
+			this->indexFile(path, entry);
+
+		for (auto& [print, name] : entry.meshes)
+			if (name == id)
+				return StSceneMeshRef{ path, name };
+	}
+
+	return std::nullopt;
+}
+
+void CSceneIndex::refresh(const std::string& folder, StFolderIndex& index)
+{
+	namespace fs = std::filesystem;
+
+	auto paths = common::findMatchingExtensionFiles(folder.c_str(), ".scne");
+	auto upper = common::findMatchingExtensionFiles(folder.c_str(), ".SCNE");
+	paths.insert(paths.end(), upper.begin(), upper.end());
+
+	// Drop removed files, keep unchanged entries - new or modified scenes are indexed on demand
+	StFolderIndex files;
+	for (auto& path : paths)
+	{
+		std::error_code error;
+		auto stamp = fs::last_write_time(path, error);
+
+		auto cached = index.find(path);
+		if (cached != index.end() && cached->second.stamp == stamp) {
+			files[path] = std::move(cached->second);
+			continue;
+		}
+
+		StFileEntry entry;
+		entry.stamp = stamp;
+		files[path] = std::move(entry);
+	}
+
+	index.swap(files);
+}
+
+void CSceneIndex::indexFile(const std::string& path, StFileEntry& entry)
+{
+	entry.indexed = true;
+	entry.meshes.clear();
+
+	try
+	{
+		CSceneFile file(path.c_str());
+		file.load();
+
+		if (file.scene())
+			for (auto& model : file.scene()->models())
+				for (auto& mesh : model->getMeshes())
+					entry.meshes.emplace_back(mesh->fingerprint.key(), mesh->name);
+	}
+	catch (...) {
+		printf("\n[CSceneIndex] WARNING: Failed to index %s", path.c_str());
+		return;
+	}
+
+	printf("\n[CSceneIndex] Indexed %s (%zu meshes)", path.c_str(), entry.meshes.size());
+}
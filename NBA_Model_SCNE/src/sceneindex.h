@@ -0,0 +1,44 @@
+/* Folder wide mesh lookup - maps mesh fingerprints and names to the .scne file that holds them */
+
+#include <string>
+#include <vector>
+#include <map>
+#include <optional>
+#include <mutex>
+#include <filesystem>
+#pragma once
+
+struct StSceneMeshRef
+{
+	std::string path; // .scne file
+	std::string name; // mesh name inside that file
+};
+
+class CSceneIndex
+{
+public:
+	static CSceneIndex& instance();
+
+public:
+	// Fingerprint first, then name. Only the fingerprints and names of each file are cached;
+	// new or changed files are loaded one at a time until the fingerprint is found.
+	std::optional<StSceneMeshRef> find(const std::string& folder, const uint64_t fingerprint, const std::string& id);
+
+private:
+	struct StFileEntry
+	{
+		bool indexed = false;
+		std::filesystem::file_time_type stamp;
+		std::vector<std::pair<uint64_t, std::string>> meshes;
+	};
+
+	using StFolderIndex = std::map<std::string, StFileEntry>;
+
+	CSceneIndex() = default;
+	void refresh(const std::string& folder, StFolderIndex& index);
+	void indexFile(const std::string& path, StFileEntry& entry);
+
+private:
+	std::map<std::string, StFolderIndex> m_folders;
+	std::mutex m_mutex;
+};
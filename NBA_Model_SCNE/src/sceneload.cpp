@@ -0,0 +1,70 @@
+#include <sceneload.h>
+#include <nbascene.h>
+
+CSceneLoad::CSceneLoad(const char* path, const StLoadOptions& options)
+	:
+	m_file(std::make_unique<CSceneFile>(path, options)),
+	m_state(LOAD_QUEUED)
+{
+	// Not on the shared pool - the load itself splits decoding across the pool workers
+	m_thread = std::thread(&CSceneLoad::run, this);
+}
+
+CSceneLoad::~CSceneLoad()
+{
+	this->cancel();
+
+	if (m_thread.joinable())
+		m_thread.join();
+}
+
+void CSceneLoad::run()
+{
+	try
+	{
+		m_file->load();
+		m_state = (m_file->scene() && !m_file->scene()->empty()) ? LOAD_DONE : LOAD_FAILED;
+	}
+	catch (const CLoadCancelled&) {
+		m_state = LOAD_CANCELLED;
+	}
+	catch (const std::exception& e) {
+		printf("\n[CSceneLoad] Failed to read scene file: %s", e.what());
+		m_state = LOAD_FAILED;
+	}
+	catch (...) {
+		m_state = LOAD_FAILED;
+	}
+}
+
+StLoadProgress CSceneLoad::poll() const
+{
+	// Handed over by finish() - only the final state is left
+	StLoadProgress progress;
+	if (m_file)
+		progress = m_file->context()->getProgress();
+
+	// The context only knows the stage it reached - the final state comes from the thread
+	int state = m_state;
+	if (state != LOAD_QUEUED)
+		progress.stage = state;
+
+	return progress;
+}
+
+void CSceneLoad::cancel()
+{
+	if (m_file)
+		m_file->context()->cancel();
+}
+
+CSceneFile* CSceneLoad::finish()
+{
+	if (m_thread.joinable())
+		m_thread.join();
+
+	if (m_state != LOAD_DONE || m_file->context()->isCancelled())
+		return nullptr;
+
+	return m_file.release();
+}
@@ -0,0 +1,29 @@
+/* Background scene load - runs CSceneFile::load on its own thread so the caller can poll progress or cancel it */
+
+#include <scenefile.h>
+#include <thread>
+#include <atomic>
+#include <memory>
+#pragma once
+
+class CSceneLoad
+{
+public:
+	CSceneLoad(const char* path, const StLoadOptions& options = StLoadOptions());
+	~CSceneLoad(); // cancels and waits for the loading thread
+
+public:
+	StLoadProgress poll() const;
+	void cancel();
+
+	// Waits for the loading thread - returns the loaded file (caller owns it from then on) or nullptr on failure / cancel
+	CSceneFile* finish();
+
+private:
+	void run();
+
+private:
+	std::unique_ptr<CSceneFile> m_file;
+	std::atomic<int> m_state; // enLoadStage once the thread is done, LOAD_QUEUED while running
+	std::thread m_thread;
+};
@@ -3,10 +3,11 @@
 #include <common.h>
 
 
-CSceneReader::CSceneReader(const char* id, JSON& json)
+CSceneReader::CSceneReader(const char* id, JSON& json, const std::shared_ptr<CLoadContext>& context)
 	:
 	CNBAScene(id),
-	m_json(json)
+	m_json(json),
+	m_context(context)
 {
 }
 
@@ -37,19 +38,29 @@ void CSceneReader::parse()
 			};
 		}
 	}
+
+	this->buildMeshIndex();
 }
 
 void CSceneReader::readModels(JSON& obj)
 {
+	int numModels = 0;
+	for (JSON::iterator it = obj.begin(); it != obj.end(); ++it)
+		numModels += it.value().is_object();
+	m_context->addModelsTotal(numModels);
+
 	for (JSON::iterator it = obj.begin(); it != obj.end(); ++it)
 	{
 		if (it.value().is_object()) {
+			m_context->checkCancelled();
+
 			std::string name = it.key();
-			auto model = std::make_shared<CModelReader>(name.c_str(), it.value());
+			auto model = std::make_shared<CModelReader>(name.c_str(), it.value(), m_context);
 
 			// check okay...
 			model->parse();
 			m_models.push_back(model);
+			m_context->addModel(model->getNumMeshes());
 		}
 	}
 
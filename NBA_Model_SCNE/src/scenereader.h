@@ -1,5 +1,6 @@
 #include <nbascene.h>
 #include <json.hpp>
+#include <loadcontext.h>
 #pragma once
 
 using JSON = nlohmann::ordered_json;
@@ -21,7 +22,7 @@ enum enMaterialTag {
 class CSceneReader : public CNBAScene
 {
 public:
-	CSceneReader(const char* name, JSON& json);
+	CSceneReader(const char* name, JSON& json, const std::shared_ptr<CLoadContext>& context);
 
 public:
 	void parse();
@@ -33,5 +34,6 @@ private:
 
 private:
 	JSON m_json;
+	std::shared_ptr<CLoadContext> m_context;
 };
 
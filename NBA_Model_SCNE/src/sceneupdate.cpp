@@ -5,8 +5,13 @@
 #include <nbamodel.h>
 #include <sstream>
 #include <bin_codec.h>
+#include <kdtree.h>
+#include <threadpool.h>
 #include <fstream>
 #include <filesystem>
+#include <cfloat>
+#include <cmath>
+#include <unordered_map>
 
 CSceneUpdate::CSceneUpdate(const char* path, const bool fix_mesh)
 	:
@@ -33,6 +38,8 @@ void CSceneUpdate::update(StUpdatePkg* data)
 	printf("\n\n========================================");
 	printf("\n[CSceneUpdate] INJECTION STARTED!");
 	printf("\n[CSceneUpdate] Inject Method: %d", m_data->search_method);
+	printf("\n[CSceneUpdate] Split Normals: %d", m_data->split_normals);
+	printf("\n[CSceneUpdate] Fingerprint: %016llx", (unsigned long long)m_data->fingerprint);
 	printf("\n[CSceneUpdate] NumVerts: %d", m_data->numVerts);
 	printf("\n[CSceneUpdate] NumFaces: %d", m_data->numFaces);
 	printf("\n========================================\n");
@@ -45,48 +52,48 @@ void CSceneUpdate::update(StUpdatePkg* data)
 	this->clear();
 }
 
-void CSceneUpdate::findTarget()
+std::shared_ptr<Mesh> CSceneUpdate::findTarget(const StUpdatePkg& data) const
 {
-	if (!m_data) {
-		printf("\n[CSceneUpdate] ERROR: m_data is NULL!");
-		return;
-	}
+	// Fingerprint first - names repeat across LODs and mirrored parts
+	if (data.fingerprint)
+		if (auto mesh = m_scene->findMesh(data.fingerprint))
+			return mesh;
 
-	printf("\n[CSceneUpdate] Searching for mesh...");
-	printf("\n  - Target NumVerts: %d", m_data->numVerts);
-	printf("\n  - Target NumFaces: %d", m_data->numFaces);
-	printf("\n  - Total models in scene: %d", m_scene->getNumModels());
+	if (auto mesh = m_scene->findMesh(data.id))
+		return mesh;
 
+	// Unlinked meshes - first one with the same topology
 	for (auto& model : m_scene->models())
-	{
-		printf("\n  - Checking model with %d meshes...", model->getNumMeshes());
-
 		for (auto& mesh : model->getMeshes())
 		{
-			// FIXED: mesh->vertices is floats, divide by 3 for vertex count
-			int meshVerts = mesh->vertices.size() / mesh->vertexComponents;  // NOT hardcoded /3
+			int meshVerts = mesh->vertices.size() / mesh->vertexComponents;
 			int meshTris = mesh->triangles.size();
 
-			printf("\n    - Mesh '%s': verts=%d, tris=%d",
-				mesh->name.c_str(), meshVerts, meshTris);
+			if (meshVerts == data.numVerts && meshTris == data.numFaces) {
+				printf("\n[CSceneUpdate] No fingerprint or name match - using mesh with equal counts");
+				return mesh;
+			}
+		}
 
-			bool hasVtxMatch = (meshVerts == m_data->numVerts);
-			bool hasTriMatch = (meshTris == m_data->numFaces);
+	return nullptr;
+}
 
-			printf(" | vtx match=%s, tri match=%s",
-				hasVtxMatch ? "YES" : "NO",
-				hasTriMatch ? "YES" : "NO");
+void CSceneUpdate::findTarget()
+{
+	if (!m_data) {
+		printf("\n[CSceneUpdate] ERROR: m_data is NULL!");
+		return;
+	}
 
-			if (hasVtxMatch && hasTriMatch)
-			{
-				printf("\n[CSceneUpdate] *** FOUND TARGET MESH: %s ***", mesh->name.c_str());
-				m_targetMesh = mesh;
-				return;
-			}
-		}
+	m_targetMesh = this->findTarget(*m_data);
+
+	if (!m_targetMesh) {
+		printf("\n[CSceneUpdate] ERROR: No mesh matches '%s' (fingerprint %016llx)",
+			m_data->id.c_str(), (unsigned long long)m_data->fingerprint);
+		return;
 	}
 
-	printf("\n[CSceneUpdate] ERROR: No matching mesh found!");
+	printf("\n[CSceneUpdate] *** FOUND TARGET MESH: %s ***", m_targetMesh->name.c_str());
 }
 
 void CSceneUpdate::updateTarget()
@@ -110,8 +117,11 @@ void CSceneUpdate::updateTarget()
 	this->getUpdatedVertices();
 	printf(" DONE");
 
-	// ✓ Skip normals entirely for split-index meshes
-	if (m_targetMesh->hasSplitIndices) {
+	// Split-index meshes keep their original normals and index buffers unless a weld was requested
+	bool keepSplit = m_targetMesh->hasSplitIndices && m_data->split_normals == SPLIT_NORMALS_PRESERVE;
+	bool updateFrames = m_targetMesh->normals_ref && !keepSplit;
+
+	if (keepSplit) {
 		printf("\n[CSceneUpdate] STEP 4: Split-index mesh - SKIPPING all normal/tangent updates");
 	}
 	else if (m_targetMesh->normals_ref) {
@@ -123,27 +133,14 @@ void CSceneUpdate::updateTarget()
 		printf("\n[CSceneUpdate] STEP 4: Skipping normals - mesh has no tangent frames");
 	}
 
-	// ✓ Simplified: Only update vertex buffer for split-index meshes
-	if (m_targetMesh->hasSplitIndices) {
-		printf("\n[CSceneUpdate] Split-index mesh detected - updating ONLY vertex buffer");
+	printf("\n[CSceneUpdate] STEP 5: updateVertexBuffer()...");
+	this->updateVertexBuffer();
+	printf(" DONE");
 
-		printf("\n[CSceneUpdate] STEP 5: updateVertexBuffer()...");
-		this->updateVertexBuffer();
+	if (updateFrames) {
+		printf("\n[CSceneUpdate] STEP 6: updateTangentBuffer()...");
+		this->updateTangentBuffer();
 		printf(" DONE");
-
-		printf("\n[CSceneUpdate] Skipping all normal/tangent buffer updates");
-	}
-	else {
-		// Standard path for non-split meshes (characters, balls)
-		printf("\n[CSceneUpdate] STEP 5: updateVertexBuffer()...");
-		this->updateVertexBuffer();
-		printf(" DONE");
-
-		if (m_targetMesh->normals_ref) {
-			printf("\n[CSceneUpdate] STEP 6: updateTangentBuffer()...");
-			this->updateTangentBuffer();
-			printf(" DONE");
-		}
 	}
 
 	// Update .scne file after all buffers saved
@@ -160,14 +157,119 @@ void CSceneUpdate::updateTarget()
 void CSceneUpdate::buildVertexMap()
 {
 	m_vertexMap.clear();
-	auto& scan_type = m_data->search_method;
-	auto& numVerts = m_data->numVerts;
+	int stride = m_targetMesh->vertexComponents;
+	size_t numTargets = m_targetMesh->vertices.size() / stride;
+	size_t numSource = std::max(0, m_data->numVerts);
 
-	// Use Vertex ID Scan
-	for (int i = 0; i < numVerts; i++) {
-		this->m_vertexMap.push_back(i);
-	};
-};
+	// Target attributes in the client space - 3 component meshes are Y-up until sent to Blender
+	bool toBlender = (stride == 3);
+	bool hasNormals = (m_targetMesh->normals.size() == numTargets * 3);
+	m_targetPositions.resize(numTargets * 3);
+	m_targetNormals.resize(hasNormals ? numTargets * 3 : 0);
+
+	for (size_t i = 0; i < numTargets; i++)
+	{
+		const float* p = &m_targetMesh->vertices[i * stride];
+		float* dst = &m_targetPositions[i * 3];
+		bool alignPos = toBlender && !m_targetMesh->isBlenderAligned;
+		dst[0] = p[0];
+		dst[1] = (alignPos) ? -p[2] : p[1];
+		dst[2] = (alignPos) ? p[1] : p[2];
+
+		if (!hasNormals)
+			continue;
+
+		const float* n = &m_targetMesh->normals[i * 3];
+		float* nrm = &m_targetNormals[i * 3];
+		nrm[0] = n[0];
+		nrm[1] = (toBlender) ? -n[2] : n[1];
+		nrm[2] = (toBlender) ? n[1] : n[2];
+	}
+
+	if (m_data->search_method == INJECT_VERTEX_ID && numSource == numTargets)
+	{
+		for (size_t i = 0; i < numTargets; i++)
+			m_vertexMap.push_back(static_cast<int>(i));
+		return;
+	}
+
+	if (m_data->search_method == INJECT_VERTEX_ID)
+		printf("\n[CSceneUpdate] Vertex count changed (%zu -> %zu) - using spatial matching", numTargets, numSource);
+
+	this->matchVerticesSpatial();
+}
+
+void CSceneUpdate::matchVerticesSpatial()
+{
+	size_t numTargets = m_targetPositions.size() / 3;
+	size_t numSource = std::max(0, m_data->numVerts);
+	m_vertexMap.assign(numTargets, -1);
+	if (numTargets == 0 || numSource == 0)
+		return;
+
+	// Radius scales with the mesh so the same setting works for balls and full characters
+	Vec3 lo{ FLT_MAX, FLT_MAX, FLT_MAX };
+	Vec3 hi{ -FLT_MAX, -FLT_MAX, -FLT_MAX };
+	for (size_t i = 0; i < numTargets; i++)
+	{
+		const float* p = &m_targetPositions[i * 3];
+		lo = Vec3{ std::min(lo.x, p[0]), std::min(lo.y, p[1]), std::min(lo.z, p[2]) };
+		hi = Vec3{ std::max(hi.x, p[0]), std::max(hi.y, p[1]), std::max(hi.z, p[2]) };
+	}
+
+	Vec3 extent = hi - lo;
+	float radius = std::max(1e-6f, INJECT_MATCH_TOLERANCE * std::sqrt(Vec3::dot(extent, extent)));
+	float radiusSq = radius * radius;
+
+	static const std::vector<float> NO_UVS;
+	const auto& targetUVs = (m_targetMesh->uvs.empty()) ? NO_UVS : m_targetMesh->uvs.front().map;
+	bool useUVs = m_data->texcoords && targetUVs.size() == numTargets * 2;
+	bool useNormals = m_data->normals && !m_targetNormals.empty();
+
+	CKdTree tree(m_data->position, numSource);
+
+	CThreadPool::instance().parallelFor(numTargets, 4096, 4096, [&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; i++)
+			{
+				const float* p = &m_targetPositions[i * 3];
+				float bestCost = FLT_MAX;
+				int match = -1;
+
+				// Closest first, UVs and normals pick between duplicated seam vertices
+				tree.forEachInRadius(p[0], p[1], p[2], radius, [&](uint32_t id, float distSq)
+					{
+						float cost = distSq / radiusSq;
+
+						if (useUVs) {
+							float du = m_data->texcoords[id * 2 + 0] - targetUVs[i * 2 + 0];
+							float dv = m_data->texcoords[id * 2 + 1] - targetUVs[i * 2 + 1];
+							cost += INJECT_UV_WEIGHT * (du * du + dv * dv);
+						}
+
+						if (useNormals) {
+							const float* n = &m_data->normals[id * 3];
+							const float* t = &m_targetNormals[i * 3];
+							cost += INJECT_NORMAL_WEIGHT * 0.5f * (1.0f - (n[0] * t[0] + n[1] * t[1] + n[2] * t[2]));
+						}
+
+						if (cost < bestCost) {
+							bestCost = cost;
+							match = static_cast<int>(id);
+						}
+					});
+
+				m_vertexMap[i] = match;
+			}
+		});
+
+	size_t numUnmatched = std::count(m_vertexMap.begin(), m_vertexMap.end(), -1);
+	printf("\n[CSceneUpdate] Spatial match: %zu / %zu vertices (radius %.6f, uvs=%s, normals=%s)",
+		numTargets - numUnmatched, numTargets, radius, useUVs ? "YES" : "NO", useNormals ? "YES" : "NO");
+
+	if (numUnmatched > 0)
+		printf("\n[CSceneUpdate] WARNING: %zu vertices had no source vertex in range - keeping original positions", numUnmatched);
+}
 
 void CSceneUpdate::getUpdatedVertices()
 {
@@ -187,9 +289,10 @@ void CSceneUpdate::getUpdatedVertices()
 	for (int i = 0; i < m_vertexMap.size(); i++)
 	{
 		auto& index = m_vertexMap[i];
-		verts.push_back(m_data->position[index * 3 + 0]);
-		verts.push_back(m_data->position[index * 3 + 1]);
-		verts.push_back(m_data->position[index * 3 + 2]);
+		const float* p = (index < 0) ? &m_targetPositions[i * 3] : &m_data->position[index * 3];
+		verts.push_back(p[0]);
+		verts.push_back(p[1]);
+		verts.push_back(p[2]);
 	}
 
 	printf("\n[getUpdatedVertices] Sample positions BEFORE transform:");
@@ -254,10 +357,9 @@ void CSceneUpdate::getUpdatedNormals()
 
 	printf("\n[getUpdatedNormals] Split indices: %s", isSplitIndex ? "YES" : "NO");
 
-	// ✓ Skip normal updates for split-index meshes for now
-	if (isSplitIndex && isR10G10B10) {
-		printf("\n[getUpdatedNormals] SKIPPING normal updates for split-index mesh");
-		printf("\n[getUpdatedNormals] (Normals will be preserved from original)");
+	// Split indices are only written for octahedral R10G10B10 frames
+	if (isSplitIndex && !isR10G10B10) {
+		printf("\n[getUpdatedNormals] SKIPPING normal updates for split-index format: %s", format.c_str());
 		return;
 	}
 
@@ -271,6 +373,7 @@ void CSceneUpdate::getUpdatedNormals()
 	// Standard per-vertex format
 	printf("\n[getUpdatedNormals] Processing STANDARD per-vertex mesh");
 
+	static const float UNMATCHED_NORMAL[3] = { 0.0f, 0.0f, 1.0f };
 	auto& normals = m_updateMesh->normals;
 	auto& tanFrames = m_targetMesh->tangent_frames;
 	printf("\n[getUpdatedNormals] vertexMap size: %zu", m_vertexMap.size());
@@ -278,9 +381,11 @@ void CSceneUpdate::getUpdatedNormals()
 	for (int i = 0; i < m_vertexMap.size(); i++)
 	{
 		auto& index = m_vertexMap[i];
-		normals.push_back(m_data->normals[index * 3 + 0]);
-		normals.push_back(m_data->normals[index * 3 + 1]);
-		normals.push_back(m_data->normals[index * 3 + 2]);
+		const float* n = (index >= 0) ? &m_data->normals[index * 3]
+			: (m_targetNormals.empty()) ? UNMATCHED_NORMAL : &m_targetNormals[i * 3];
+		normals.push_back(n[0]);
+		normals.push_back(n[1]);
+		normals.push_back(n[2]);
 	}
 	printf("\n[getUpdatedNormals] Loaded %zu normals", normals.size());
 
@@ -293,6 +398,12 @@ void CSceneUpdate::getUpdatedNormals()
 		printf("\n[getUpdatedNormals] Skipping normal alignment for 4-component mesh");
 	}
 
+	// Split-index frames are rebuilt from these normals in updateTangentBuffer
+	if (isSplitIndex) {
+		printf("\n[getUpdatedNormals] Complete! (split-index normals)");
+		return;
+	}
+
 	// Update tangent frame vectors 
 	printf("\n[getUpdatedNormals] Calling updateTangentFrameVec...");
 	printf("\n  - tanFrames size: %zu", tanFrames.size());
@@ -309,6 +420,34 @@ void CSceneUpdate::getUpdatedNormals()
 	printf("\n[getUpdatedNormals] Complete!");
 }
 
+// Writes per-vertex values into 'src' - group views scatter each run of consecutive full mesh vertices in place
+static void updateVertexStream(CDataBuffer* buffer, char* src, const std::vector<float>& data, const Mesh& target)
+{
+	BinaryCodec codec(buffer->getEncoding(), buffer->getType());
+	auto& sourceVertices = target.sourceVertices;
+	uint64_t offset = buffer->getDataOffset();
+	uint32_t stride = buffer->getStride();
+
+	if (sourceVertices.empty()) {
+		codec.update(src, data.size(), data, offset, stride);
+		return;
+	}
+
+	size_t numVerts = sourceVertices.size();
+	size_t numValues = (numVerts) ? data.size() / numVerts : 0;
+	std::vector<float> run;
+
+	for (size_t begin = 0, end = 0; begin < numVerts; begin = end)
+	{
+		for (end = begin + 1; end < numVerts && sourceVertices[end] == sourceVertices[end - 1] + 1; end++);
+
+		run.assign(data.begin() + begin * numValues, data.begin() + end * numValues);
+		codec.update(src, run.size(), run, offset + uint64_t(sourceVertices[begin]) * stride, stride);
+	}
+
+	printf("\n[CSceneUpdate] Scattered %zu group vertices into the shared buffer", numVerts);
+}
+
 void CSceneUpdate::updateVertexBuffer()
 {
 	auto posBf = (CDataBuffer*)m_targetMesh->vertex_ref;
@@ -344,12 +483,10 @@ void CSceneUpdate::updateVertexBuffer()
 				transformedVerts[i * 3], transformedVerts[i * 3 + 1], transformedVerts[i * 3 + 2]);
 		}
 
-		BinaryCodec codec(posBf->getEncoding(), posBf->getType());
-		codec.update(src, transformedVerts.size(), transformedVerts, posBf->getDataOffset(), posBf->getStride());
+		::updateVertexStream(posBf, src, transformedVerts, *m_targetMesh);
 	}
 	else {
-		BinaryCodec codec(posBf->getEncoding(), posBf->getType());
-		codec.update(src, mesh_data.size(), mesh_data, posBf->getDataOffset(), posBf->getStride());
+		::updateVertexStream(posBf, src, mesh_data, *m_targetMesh);
 	}
 
 	// ✓ Skip hash increment for split-index meshes
@@ -386,10 +523,32 @@ void CSceneUpdate::updateTangentBuffer()
 	char* src = (char*)buffer.data();
 
 	// Handle split index meshes differently
-	if (m_targetMesh->hasSplitIndices && format == "R10G10B10_SNORM_A2_UNORM")
+	if (m_targetMesh->hasSplitIndices)
 	{
+		if (format != "R10G10B10_SNORM_A2_UNORM" || m_updateMesh->normals.empty()) {
+			printf("\n[updateTangentBuffer] Split-index mesh without updated normals - keeping original frames");
+			return;
+		}
+
+		// The unique normals are shared by every group of the model
+		if (!m_targetMesh->sourceVertices.empty()) {
+			printf("\n[updateTangentBuffer] Split-index group view - keeping original frames");
+			return;
+		}
+
 		printf("\n[updateTangentBuffer] Updating SPLIT INDEX mesh with unique normals");
 
+		// Weld the per-vertex normals into a new unique set and per-vertex indices
+		this->rebuildSplitIndexBuffers(m_data->split_normals == SPLIT_NORMALS_WELD_ENCODED);
+
+		// The unique list can't grow past the original buffer
+		size_t capacity = m_targetMesh->uniqueNormals.size() / 3;
+		if (m_updateMesh->uniqueNormals.size() / 3 > capacity) {
+			printf("\n[updateTangentBuffer] WARNING: %zu welded normals exceed the %zu buffer entries - keeping original frames",
+				m_updateMesh->uniqueNormals.size() / 3, capacity);
+			return;
+		}
+
 		// Encode unique normals back to octahedral R10G10B10
 		std::vector<float> encodedNormals;
 		encodeOctahedralNormals(m_updateMesh->uniqueNormals, encodedNormals);
@@ -399,6 +558,9 @@ void CSceneUpdate::updateTangentBuffer()
 		BinaryCodec codec(tanBf->getEncoding(), tanBf->getType());
 		codec.update(src, encodedNormals.size(), encodedNormals, tanBf->getDataOffset(), tanBf->getStride());
 
+		this->updateNormalIndexBuffer();
+		this->updateTangentIndexBuffer();
+
 		printf("\n[updateTangentBuffer] Updated tangent buffer with encoded normals");
 	}
 	else
@@ -412,8 +574,7 @@ void CSceneUpdate::updateTangentBuffer()
 			return;
 		}
 
-		BinaryCodec codec(tanBf->getEncoding(), tanBf->getType());
-		codec.update(src, mesh_data.size(), mesh_data, tanBf->getDataOffset(), tanBf->getStride());
+		::updateVertexStream(tanBf, src, mesh_data, *m_targetMesh);
 	}
 
 	// ✓ Skip hash increment for split-index meshes
@@ -466,94 +627,109 @@ std::string CSceneUpdate::incrementHash(const std::string& filename)
 	return newFilename;
 }
 
-void CSceneUpdate::rebuildSplitIndexBuffers()
+// Hash grid over unique normals - a tolerance match can only sit in the 27 cells around the query
+struct StNormalWeld
 {
-	// ✓ Skip for split-index meshes - they already have correct unique normals
-	// and we must preserve the original index structure
-	if (m_targetMesh->hasSplitIndices) {
-		printf("\n[rebuildSplitIndexBuffers] Split-index mesh detected - skipping rebuild");
-		printf("\n[rebuildSplitIndexBuffers] Using original index structure with updated unique normals");
-		printf("\n[rebuildSplitIndexBuffers] Original normal indices: %zu", m_targetMesh->normalIndices.size());
-		printf("\n[rebuildSplitIndexBuffers] Updated unique normals: %zu", m_updateMesh->uniqueNormals.size() / 3);
-
-		// Keep original indices unchanged
-		m_updateMesh->normalIndices = m_targetMesh->normalIndices;
-		m_updateMesh->tangentIndices = m_targetMesh->tangentIndices;
-
-		// Unique normals were already built in getUpdatedNormals()
-		// Just confirm they exist
-		if (m_updateMesh->uniqueNormals.empty()) {
-			printf("\n[rebuildSplitIndexBuffers] WARNING: No unique normals found!");
+	std::vector<float>& unique;
+	bool encoded;
+	std::unordered_map<uint64_t, uint32_t> heads; // cell -> newest normal in it
+	std::vector<uint32_t> next;                   // older normals of the same cell
+
+	static constexpr uint32_t NONE = UINT32_MAX;
+
+	static uint64_t cellKey(const int64_t x, const int64_t y, const int64_t z)
+	{
+		constexpr uint64_t MASK = (1ull << 21) - 1;
+		return (uint64_t(x) & MASK) | ((uint64_t(y) & MASK) << 21) | ((uint64_t(z) & MASK) << 42);
+	}
+
+	uint32_t push(const Vec3& normal)
+	{
+		unique.push_back(normal.x);
+		unique.push_back(normal.y);
+		unique.push_back(normal.z);
+		return static_cast<uint32_t>(unique.size() / 3 - 1);
+	}
+
+	uint32_t weld(const Vec3& normal)
+	{
+		// Same 10-bit code means the game can't tell them apart
+		if (encoded) {
+			Vec4 code{ 0, 0, 0, 0 };
+			MeshCalc::EncodeOctahedralNormal(&code, normal);
+			auto key = (uint64_t(uint32_t(code.x)) << 10) | uint32_t(code.y);
+			auto found = heads.find(key);
+			if (found != heads.end())
+				return found->second;
+			return heads[key] = this->push(normal);
 		}
 
-		return;
+		int64_t cell[3] = {
+			int64_t(std::floor(normal.x / NORMAL_WELD_TOLERANCE)),
+			int64_t(std::floor(normal.y / NORMAL_WELD_TOLERANCE)),
+			int64_t(std::floor(normal.z / NORMAL_WELD_TOLERANCE)) };
+
+		// Lowest index wins, same result as scanning the list in order
+		uint32_t match = NONE;
+		for (int dx = -1; dx <= 1; dx++)
+			for (int dy = -1; dy <= 1; dy++)
+				for (int dz = -1; dz <= 1; dz++)
+				{
+					auto found = heads.find(cellKey(cell[0] + dx, cell[1] + dy, cell[2] + dz));
+					if (found == heads.end())
+						continue;
+
+					for (uint32_t i = found->second; i != NONE; i = next[i])
+					{
+						float diff = fabsf(normal.x - unique[i * 3 + 0]) +
+							fabsf(normal.y - unique[i * 3 + 1]) +
+							fabsf(normal.z - unique[i * 3 + 2]);
+
+						if (diff < NORMAL_WELD_TOLERANCE && i < match)
+							match = i;
+					}
+				}
+
+		if (match != NONE)
+			return match;
+
+		auto& head = heads.try_emplace(cellKey(cell[0], cell[1], cell[2]), NONE).first->second;
+		match = this->push(normal);
+		next.push_back(head);
+		head = match;
+		return match;
 	}
+};
 
-	// ✓ Original code for NON-split meshes
+void CSceneUpdate::rebuildSplitIndexBuffers(const bool weldEncoded)
+{
 	printf("\n[rebuildSplitIndexBuffers] Re-optimizing per-vertex normals to split indices");
 
 	auto& normals = m_updateMesh->normals;
+	size_t numVerts = normals.size() / 3;
 
-	// Build unique normal list with tolerance
-	constexpr float TOLERANCE = 0.0001f;
+	// Build unique normal list with tolerance - index buffers hold one entry per vertex
 	std::vector<float> uniqueNormals;
 	std::vector<uint16_t> newNormalIndices;
 
 	uniqueNormals.reserve(normals.size() / 2);
-	newNormalIndices.reserve(m_targetMesh->triangles.size() * 3);
+	newNormalIndices.reserve(numVerts);
+	StNormalWeld welder{ uniqueNormals, weldEncoded };
 
-	// For each triangle corner
-	for (size_t triIdx = 0; triIdx < m_targetMesh->triangles.size(); triIdx++)
+	for (size_t vertIdx = 0; vertIdx < numVerts; vertIdx++)
 	{
-		auto& tri = m_targetMesh->triangles[triIdx];
-
-		for (int corner = 0; corner < 3; corner++)
-		{
-			uint32_t vertIdx = tri[corner];
-			if (vertIdx * 3 + 2 >= normals.size()) {
-				printf("\n[rebuildSplitIndexBuffers] ERROR: Vertex %d out of range", vertIdx);
-				newNormalIndices.push_back(0);
-				continue;
-			}
-
-			Vec3 normal{
-				normals[vertIdx * 3 + 0],
-				normals[vertIdx * 3 + 1],
-				normals[vertIdx * 3 + 2]
-			};
-
-			// Search for matching normal in unique list
-			int matchIdx = -1;
-			for (size_t i = 0; i < uniqueNormals.size() / 3; i++)
-			{
-				Vec3 existing{
-					uniqueNormals[i * 3 + 0],
-					uniqueNormals[i * 3 + 1],
-					uniqueNormals[i * 3 + 2]
-				};
-
-				float diff = fabsf(normal.x - existing.x) +
-					fabsf(normal.y - existing.y) +
-					fabsf(normal.z - existing.z);
-
-				if (diff < TOLERANCE) {
-					matchIdx = i;
-					break;
-				}
-			}
-
-			// Add to unique list if not found
-			if (matchIdx == -1) {
-				matchIdx = uniqueNormals.size() / 3;
-				uniqueNormals.push_back(normal.x);
-				uniqueNormals.push_back(normal.y);
-				uniqueNormals.push_back(normal.z);
-			}
+		Vec3 normal{
+			normals[vertIdx * 3 + 0],
+			normals[vertIdx * 3 + 1],
+			normals[vertIdx * 3 + 2]
+		};
 
-			newNormalIndices.push_back(static_cast<uint16_t>(matchIdx));
-		}
+		newNormalIndices.push_back(static_cast<uint16_t>(welder.weld(normal)));
 	}
 
+	if (uniqueNormals.size() / 3 > UINT16_MAX + 1)
+		printf("\n[rebuildSplitIndexBuffers] WARNING: %zu unique normals exceed 16-bit indices", uniqueNormals.size() / 3);
+
 	// Update mesh with new unique normals and indices
 	m_updateMesh->uniqueNormals = uniqueNormals;
 	m_updateMesh->normalIndices = newNormalIndices;
@@ -579,8 +755,8 @@ void CSceneUpdate::rebuildSplitIndexBuffers()
 		m_updateMesh->uniqueTangents.push_back(encoded.w);
 	}
 
-	printf("\n[rebuildSplitIndexBuffers] Optimized %zu normals to %zu unique normals",
-		normals.size() / 3, uniqueNormals.size() / 3);
+	printf("\n[rebuildSplitIndexBuffers] Optimized %zu normals to %zu unique normals (%s weld)",
+		numVerts, uniqueNormals.size() / 3, weldEncoded ? "octahedral" : "float");
 }
 
 void CSceneUpdate::updateNormalIndexBuffer()
@@ -664,23 +840,11 @@ void CSceneUpdate::updateSceneFile()
 		return;
 	}
 
-	// Find .scne file in working directory
+	// Write back to the scene this update was loaded from
 	namespace fs = std::filesystem;
-	std::string scenePath;
-
-	for (const auto& entry : fs::directory_iterator(WORKING_DIR)) {
-		if (entry.path().extension() == ".scne" || entry.path().extension() == ".SCNE") {
-			scenePath = entry.path().string();
-			break;
-		}
-	}
-
-	if (scenePath.empty()) {
-		printf("\n[ERROR] No .scne file found in: %s", WORKING_DIR.c_str());
-		return;
-	}
+	std::string scenePath = m_path;
 
-	printf("\n[CSceneUpdate] Found .scne file: %s", scenePath.c_str());
+	printf("\n[CSceneUpdate] Updating .scne file: %s", scenePath.c_str());
 
 	// Use map to prevent duplicates
 	std::map<std::string, std::string> bufferUpdates;
@@ -3,16 +3,36 @@
 #include <scenefile.h>
 #pragma once
 
+#define INJECT_MATCH_TOLERANCE 0.002f // search radius as a fraction of the target bounding box diagonal
+#define INJECT_UV_WEIGHT       1.0f   // tie-break cost per squared UV distance
+#define INJECT_NORMAL_WEIGHT   0.5f   // tie-break cost for opposite normals
+#define NORMAL_WELD_TOLERANCE  0.0001f // L1 distance below which split normals share an index
+
+enum enInjectMethod
+{
+    INJECT_SPATIAL   = 0, // nearest client vertex by position, UVs and normals
+    INJECT_VERTEX_ID = 1, // client order equals game order (falls back to spatial on count mismatch)
+};
+
+enum enSplitNormals
+{
+    SPLIT_NORMALS_PRESERVE     = 0, // split-index meshes keep their original normals and index buffers
+    SPLIT_NORMALS_WELD         = 1, // weld client normals within NORMAL_WELD_TOLERANCE and rewrite the index buffers
+    SPLIT_NORMALS_WELD_ENCODED = 2, // weld client normals with equal 10-bit octahedral codes
+};
+
 struct Mesh;
 struct StUpdatePkg
 {
     std::string id;
+    uint64_t fingerprint; // MeshFingerprint::key() of the linked game mesh, 0 if unknown
     float* position;
     float* texcoords;
     float* normals;
     int numVerts;
     int numFaces;
     int search_method;
+    int split_normals; // enSplitNormals
 };
 
 class CSceneUpdate : public CSceneFile
@@ -25,10 +45,14 @@ public:
 	void update(StUpdatePkg* data);
     void clear();
 
+    // Fingerprint, then name, then the first mesh with equal vertex/triangle counts
+    std::shared_ptr<Mesh> findTarget(const StUpdatePkg& data) const;
+
 private:
     void updateTarget();
     void findTarget();
     void buildVertexMap();
+    void matchVerticesSpatial();
    
 private:
     void getUpdatedVertices();
@@ -42,13 +66,15 @@ private:
     StUpdatePkg* m_data;
     std::shared_ptr<Mesh> m_updateMesh;
     std::shared_ptr<Mesh> m_targetMesh;
-    std::vector<int> m_vertexMap; // holds vertex index id
+    std::vector<int> m_vertexMap; // client vertex per target vertex, -1 if unmatched
+    std::vector<float> m_targetPositions; // target xyz in client (Blender) space
+    std::vector<float> m_targetNormals;
 private:
     void updateSceneFile();
     void encodeOctahedralNormals(const std::vector<float>& normals, std::vector<float>& encoded);
 
     // ✓ NEW: Split index buffer methods
-    void rebuildSplitIndexBuffers();
+    void rebuildSplitIndexBuffers(const bool weldEncoded); // weldEncoded: merge normals with equal 10-bit octahedral codes instead of NORMAL_WELD_TOLERANCE
     void updateNormalIndexBuffer();
     void updateTangentIndexBuffer();
     std::string incrementHash(const std::string& filename);
@@ -0,0 +1,123 @@
+#include <threadpool.h>
+#include <atomic>
+#include <memory>
+#include <exception>
+#include <algorithm>
+
+// Shared state for a single parallelFor call - outlives late helpers that find no work left
+struct StChunkJob
+{
+	std::function<void(size_t, size_t)> fn;
+	size_t items = 0;
+	size_t chunk = 0;
+	size_t numChunks = 0;
+
+	std::atomic<size_t> next{ 0 };
+	std::atomic<size_t> done{ 0 };
+	std::exception_ptr error;
+
+	std::mutex mutex;
+	std::condition_variable cv;
+
+	void run()
+	{
+		size_t index;
+		while ((index = next.fetch_add(1)) < numChunks)
+		{
+			size_t begin = index * chunk;
+			size_t end = std::min(begin + chunk, items);
+
+			try {
+				fn(begin, end);
+			}
+			catch (...) {
+				std::lock_guard<std::mutex> lock(mutex);
+				if (!error) error = std::current_exception();
+			}
+
+			if (done.fetch_add(1) + 1 == numChunks) {
+				std::lock_guard<std::mutex> lock(mutex);
+				cv.notify_all();
+			}
+		}
+	}
+};
+
+CThreadPool::CThreadPool()
+{
+	unsigned int numThreads = std::thread::hardware_concurrency();
+	numThreads = (numThreads > 1) ? numThreads - 1 : 1;
+
+	for (unsigned int i = 0; i < numThreads; i++)
+		m_workers.emplace_back(&CThreadPool::workerLoop, this);
+}
+
+CThreadPool& CThreadPool::instance()
+{
+	// Never destroyed - joining workers while the DLL unloads can deadlock under the loader lock
+	static CThreadPool* pool = new CThreadPool();
+	return *pool;
+}
+
+size_t CThreadPool::getNumWorkers() const
+{
+	return m_workers.size();
+}
+
+void CThreadPool::submit(std::function<void()> task)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_tasks.push(std::move(task));
+	}
+	m_cv.notify_one();
+}
+
+void CThreadPool::workerLoop()
+{
+	for (;;)
+	{
+		std::function<void()> task;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_cv.wait(lock, [this] { return !m_tasks.empty(); });
+			task = std::move(m_tasks.front());
+			m_tasks.pop();
+		}
+		task();
+	}
+}
+
+void CThreadPool::parallelFor(
+	const size_t items,
+	const size_t chunk,
+	const size_t threshold,
+	const std::function<void(size_t, size_t)>& fn)
+{
+	if (items == 0)
+		return;
+
+	if (items < threshold || chunk == 0 || items <= chunk || m_workers.empty()) {
+		fn(0, items);
+		return;
+	}
+
+	auto job = std::make_shared<StChunkJob>();
+	job->fn = fn;
+	job->items = items;
+	job->chunk = chunk;
+	job->numChunks = (items + chunk - 1) / chunk;
+
+	// The calling thread works too, so nested calls from a worker can't starve
+	size_t numHelpers = std::min(m_workers.size(), job->numChunks - 1);
+	for (size_t i = 0; i < numHelpers; i++)
+		this->submit([job] { job->run(); });
+
+	job->run();
+
+	std::unique_lock<std::mutex> lock(job->mutex);
+	job->cv.wait(lock, [&] { return job->done.load() == job->numChunks; });
+
+	if (job->error)
+		std::rethrow_exception(job->error);
+}
@@ -0,0 +1,37 @@
+/* Shared worker pool used to split large, independent workloads across cores */
+
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#pragma once
+
+class CThreadPool
+{
+public:
+	static CThreadPool& instance();
+
+public:
+	size_t getNumWorkers() const;
+
+	// Runs fn(begin, end) over [0, items) in chunks of 'chunk' elements and blocks until all are done.
+	// Workloads smaller than 'threshold' run on the calling thread.
+	void parallelFor(
+		const size_t items,
+		const size_t chunk,
+		const size_t threshold,
+		const std::function<void(size_t, size_t)>& fn);
+
+private:
+	CThreadPool();
+	void submit(std::function<void()> task);
+	void workerLoop();
+
+private:
+	std::vector<std::thread> m_workers;
+	std::queue<std::function<void()>> m_tasks;
+	std::mutex m_mutex;
+	std::condition_variable m_cv;
+};